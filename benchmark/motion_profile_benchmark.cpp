@@ -0,0 +1,727 @@
+#include <new>
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <chrono>
+#include <string>
+#include <vector>
+#include <cmath>
+#include <limits>
+#include <random>
+#include <algorithm>
+#include <filesystem>
+#include <thread>
+#if defined(_WIN32)
+#include <malloc.h>
+#endif
+#include "motion_profile_sigmoid/motion_profile_sigmoid.h"
+#include "motion_profile_sigmoid/motion_profile_sigmoid_table.h"
+#include "motion_profile_sigmoid/motion_profile_sigmoid_cache.h"
+#include "motion_profile_sigmoid/motion_profile_sigmoid_replan.h"
+#include "motion_profile_sigmoid/motion_profile_sigmoid_multi_axis.h"
+#include "motion_profile_sigmoid/motion_profile_sigmoid_duration.h"
+#include "motion_profile_trapezoidal/motion_profile_trapezoidal.h"
+#include "motion_profile_trajectory/motion_profile_trajectory.h"
+#include "motion_profile_fixed/motion_profile_fixed.h"
+#include "motion_profile_instrumentation/motion_profile_instrumentation.h"
+#include "motion_profile_bulk/motion_profile_bulk.h"
+#include "motion_profile_stream/motion_profile_stream.h"
+
+#define BENCHMARK_QUERY_COUNT 1024  // queries are cycled through (power of two)
+#define BENCHMARK_TIME_MIN    0.01  // seconds a single repetition runs at least
+#define BENCHMARK_REPETITIONS 5     // the fastest repetition is reported
+#define BENCHMARK_TIME_STEP   0.001f
+#define BENCHMARK_PLAN_MOVES  4096  // moves per parallel planning batch
+#define BENCHMARK_WAYPOINTS   512   // waypoints of the benchmarked trajectory
+#define BENCHMARK_CACHE_MOVES 256   // distinct moves asked of the profile cache
+#define BENCHMARK_REPLANS     65536 // individually timed replans of random in-motion states
+#define BENCHMARK_FIXED_TICKS 100000 // ticks the fixed point accuracy is checked at
+#define BENCHMARK_BULK_MOVES  256    // moves per bulk file (about 1500 samples each)
+#define BENCHMARK_DURATION_MOVES 1024 // limit sets per duration batch, over all three branches
+#define BENCHMARK_STREAM_SETPOINTS 1048576 // setpoints passed through the ring as fast as possible
+#define BENCHMARK_STREAM_CAPACITY  256     // setpoints the paced ring buffers ahead
+#define BENCHMARK_STREAM_SECONDS   0.5     // seconds every paced tick rate runs
+
+// one parameter set per branch of sigmoid_phase_anchors_time
+struct BenchmarkRegime {
+	const char* regime_name;
+	float       distance_total;
+	float       velocity_max;
+	float       acceleration_max;
+	float       jerk;
+};
+
+const BenchmarkRegime benchmark_regimes[3] = {
+	{"short_move", 100.0f, 50.0f, 5.0f, 2.0f}, // full acceleration, shortened retain, no drift
+	{"no_retain",  20.0f,  10.0f, 5.0f, 2.0f}, // acceleration limit never reached
+	{"long_drift", 300.0f, 50.0f, 5.0f, 2.0f}  // cruises at the velocity limit
+};
+
+struct BenchmarkResult {
+	std::string benchmark_name;
+	std::string regime_name;
+	double      ns_per_op;
+	long long   iterations;
+	double      allocations_per_op;
+	bool        realtime;           // part of the real time api, which must never allocate
+};
+
+// worst deviation of a backend from the segments evaluated exactly (in double) at the same times
+struct BenchmarkAccuracy {
+	std::string benchmark_name;
+	std::string regime_name;
+	double      error_max[3];   // distance, velocity and acceleration
+	double      error_bound[3]; // documented bound (negative without one)
+};
+
+std::vector<BenchmarkResult>   benchmark_results;
+std::vector<BenchmarkAccuracy> benchmark_accuracies;
+volatile float               benchmark_sink;
+int                          benchmark_stream_violations = 0; // setpoints that came out of the ring out of order
+bool                         benchmark_realtime = false; // results recorded while set belong to the real time api
+std::atomic<long long>       benchmark_allocation_count = 0;
+
+// every allocation of the process goes through here and is counted, over-aligned ones too (the array forms forward to
+// these)
+void* operator new(size_t allocation_size) {
+	benchmark_allocation_count.fetch_add(1, std::memory_order_relaxed);
+	void* allocation = std::malloc(allocation_size > 0 ? allocation_size : 1);
+	if (allocation == nullptr) throw std::bad_alloc();
+	return allocation;
+}
+
+void* operator new(size_t allocation_size, std::align_val_t allocation_alignment) {
+	benchmark_allocation_count.fetch_add(1, std::memory_order_relaxed);
+	size_t alignment  = std::max((size_t) allocation_alignment, sizeof(void*));
+	void*  allocation = nullptr;
+#if defined(_WIN32)
+	allocation = _aligned_malloc(allocation_size > 0 ? allocation_size : 1, alignment);
+#else
+	if (posix_memalign(&allocation, alignment, allocation_size > 0 ? allocation_size : 1) != 0) allocation = nullptr;
+#endif
+	if (allocation == nullptr) throw std::bad_alloc();
+	return allocation;
+}
+
+// releases outside the operators, so gcc does not pair an inlined free with operator new (-Wmismatched-new-delete)
+#if defined(__GNUC__) || defined(__clang__)
+__attribute__((noinline))
+#endif
+void benchmark_free(void* allocation, bool allocation_aligned) noexcept {
+#if defined(_WIN32)
+	if (allocation_aligned) {
+		_aligned_free(allocation);
+		return;
+	}
+#endif
+	(void) allocation_aligned;
+	std::free(allocation);
+}
+
+void operator delete(void* allocation) noexcept {
+	benchmark_free(allocation, false);
+}
+
+void operator delete(void* allocation, size_t) noexcept {
+	benchmark_free(allocation, false);
+}
+
+void operator delete(void* allocation, std::align_val_t) noexcept {
+	benchmark_free(allocation, true);
+}
+
+void operator delete(void* allocation, size_t, std::align_val_t) noexcept {
+	benchmark_free(allocation, true);
+}
+
+// times operation(query_index) and reports the cost of one of its items (a call, a sample or a tick)
+template <typename Operation>
+void benchmark_run(const char* benchmark_name, const char* regime_name, int operation_items, Operation operation) {
+	long long iterations        = 16;
+	double    time_elapsed      = 0.0;
+	double    time_best         = std::numeric_limits<double>::infinity();
+	long long allocations_timed = 0;
+	for (int repetition = -1; repetition < BENCHMARK_REPETITIONS; repetition++) {
+		long long allocation_count_begin = benchmark_allocation_count.load(std::memory_order_relaxed);
+		do {
+			float value_sink = 0.0f;
+			std::chrono::steady_clock::time_point time_begin = std::chrono::steady_clock::now();
+			for (long long iteration = 0; iteration < iterations; iteration++) value_sink += operation((int) (iteration & (BENCHMARK_QUERY_COUNT - 1)));
+			time_elapsed   = std::chrono::duration<double>(std::chrono::steady_clock::now() - time_begin).count();
+			benchmark_sink = value_sink;
+			// calibrate the iteration count during the first (unreported) repetition
+			if (repetition < 0 && time_elapsed < BENCHMARK_TIME_MIN) iterations *= 2;
+			else break;
+		} while (true);
+		if (repetition >= 0) {
+			time_best          = std::min(time_best, time_elapsed);
+			allocations_timed += benchmark_allocation_count.load(std::memory_order_relaxed) - allocation_count_begin;
+		}
+	}
+	benchmark_results.push_back({benchmark_name, regime_name, time_best * 1e9 / ((double) iterations * operation_items), iterations, (double) allocations_timed / ((double) iterations * BENCHMARK_REPETITIONS), benchmark_realtime});
+	fprintf(stderr, "%-44s %-10s %10.2f ns/op\n", benchmark_name, regime_name, benchmark_results.back().ns_per_op);
+}
+
+// fixed point export of a profile: query cost next to the float path, and its error against the exact segments over
+// a dense sweep of ticks (the float path is checked on the same times for comparison). the evaluator is rebuilt from
+// copies of the exported integers the way a target would, so everything measured runs on the target side path
+void benchmark_fixed(const char* profile_name, const char* regime_name, const MotionProfileSegment* segments, int segment_count, float time_end) {
+	MotionProfileFixedErrorBounds          fixed_bounds   = {};
+	MotionProfileFixed                     fixed_export   = motion_profile_fixed_export(segments, segment_count, time_end, &fixed_bounds);
+	std::vector<MotionProfileFixedSegment> fixed_segments = std::vector<MotionProfileFixedSegment>(fixed_export.get_segments(), fixed_export.get_segments() + fixed_export.get_segment_count());
+	MotionProfileFixed                     fixed_profile  = MotionProfileFixed(fixed_segments.data(), (int) fixed_segments.size(), fixed_export.get_time_end(), fixed_export.get_format());
+	MotionProfileFixedFormat               fixed_format   = fixed_profile.get_format();
+	std::vector<int32_t>     query_ticks   = std::vector<int32_t>(BENCHMARK_QUERY_COUNT);
+	for (int query_index = 0; query_index < BENCHMARK_QUERY_COUNT; query_index++) query_ticks[query_index] = (int32_t) ((int64_t) fixed_profile.get_time_end() * query_index / (BENCHMARK_QUERY_COUNT - 1));
+	std::string benchmark_name = std::string(profile_name) + "_fixed";
+	benchmark_run((benchmark_name + "_get_time_distance").c_str(),     regime_name, 1, [&](int query_index) { return (float) fixed_profile.get_time_distance(query_ticks[query_index]); });
+	benchmark_run((benchmark_name + "_get_time_velocity").c_str(),     regime_name, 1, [&](int query_index) { return (float) fixed_profile.get_time_velocity(query_ticks[query_index]); });
+	benchmark_run((benchmark_name + "_get_time_acceleration").c_str(), regime_name, 1, [&](int query_index) { return (float) fixed_profile.get_time_acceleration(query_ticks[query_index]); });
+	BenchmarkAccuracy fixed_accuracy = {benchmark_name, regime_name, {0, 0, 0}, {fixed_bounds.distance, fixed_bounds.velocity, fixed_bounds.acceleration}};
+	BenchmarkAccuracy float_accuracy = {std::string(profile_name) + "_float", regime_name, {0, 0, 0}, {-1, -1, -1}};
+	for (int tick_index = 0; tick_index < BENCHMARK_FIXED_TICKS; tick_index++) {
+		int32_t progress_tick = (int32_t) ((int64_t) fixed_profile.get_time_end() * tick_index / (BENCHMARK_FIXED_TICKS - 1));
+		double  progress_time = motion_profile_fixed_decode(progress_tick, fixed_format.time_fraction_bits);
+		int     segment_index = motion_profile_segment_search(segments, segment_count, (float) progress_time);
+		// exact reference in double, and the float path at the nearest float time
+		const MotionProfileSegment& segment         = segments[segment_index];
+		BasicMotionProfileSegment<double> segment_double = {segment.time_begin, segment.cubic_degree_third, segment.cubic_degree_second, segment.cubic_degree_first, segment.cubic_degree_zero};
+		double time_section       = progress_time - segment.time_begin;
+		float  time_section_float = (float) progress_time - segment.time_begin;
+		double values_exact[3]    = {motion_profile_segment_distance(segment_double, time_section), motion_profile_segment_velocity(segment_double, time_section), motion_profile_segment_acceleration(segment_double, time_section)};
+		double values_fixed[3]    = {
+			motion_profile_fixed_decode(fixed_profile.get_time_distance(progress_tick),     fixed_format.distance_fraction_bits),
+			motion_profile_fixed_decode(fixed_profile.get_time_velocity(progress_tick),     fixed_format.velocity_fraction_bits),
+			motion_profile_fixed_decode(fixed_profile.get_time_acceleration(progress_tick), fixed_format.acceleration_fraction_bits)
+		};
+		double values_float[3]    = {motion_profile_segment_distance(segment, time_section_float), motion_profile_segment_velocity(segment, time_section_float), motion_profile_segment_acceleration(segment, time_section_float)};
+		for (int value_index = 0; value_index < 3; value_index++) {
+			fixed_accuracy.error_max[value_index] = std::max(fixed_accuracy.error_max[value_index], std::fabs(values_fixed[value_index] - values_exact[value_index]));
+			float_accuracy.error_max[value_index] = std::max(float_accuracy.error_max[value_index], std::fabs(values_float[value_index] - values_exact[value_index]));
+		}
+	}
+	for (const BenchmarkAccuracy& accuracy : {fixed_accuracy, float_accuracy}) {
+		fprintf(stderr, "%-44s %-10s error %.3g %.3g %.3g (bound %.3g %.3g %.3g)\n", accuracy.benchmark_name.c_str(), regime_name,
+			accuracy.error_max[0], accuracy.error_max[1], accuracy.error_max[2], accuracy.error_bound[0], accuracy.error_bound[1], accuracy.error_bound[2]);
+		benchmark_accuracies.push_back(accuracy);
+	}
+}
+
+void benchmark_regime(const BenchmarkRegime& regime) {
+	const char*          regime_name      = regime.regime_name;
+	SigmoidMotionProfile sigmoid_profile  = SigmoidMotionProfile(regime.distance_total, regime.velocity_max, regime.acceleration_max, regime.jerk);
+	float                sigmoid_time_end = sigmoid_profile.get_time_end();
+	// query inputs spread over the whole motion
+	std::vector<float> query_times(BENCHMARK_QUERY_COUNT);
+	std::vector<float> query_distances(BENCHMARK_QUERY_COUNT);
+	std::vector<float> query_outputs[4];
+	for (int query_index = 0; query_index < BENCHMARK_QUERY_COUNT; query_index++) {
+		query_times[query_index]     = sigmoid_time_end * query_index / (BENCHMARK_QUERY_COUNT - 1);
+		query_distances[query_index] = regime.distance_total * query_index / (BENCHMARK_QUERY_COUNT - 1);
+	}
+	for (int output_index = 0; output_index < 4; output_index++) query_outputs[output_index].resize(BENCHMARK_QUERY_COUNT);
+	MotionProfileSamples query_samples = {query_outputs[0].data(), query_outputs[1].data(), query_outputs[2].data(), query_outputs[3].data()};
+	// the cubic each distance query hands to the solver (phase polynomial shifted by the distance)
+	std::vector<SigmoidMotionProfile::SigmoidCubicConstants> query_cubics(BENCHMARK_QUERY_COUNT);
+	for (int query_index = 0; query_index < BENCHMARK_QUERY_COUNT; query_index++) {
+		float                                     query_time   = sigmoid_profile.get_distance_time(query_distances[query_index]);
+		SigmoidMotionProfile::SigmoidPhaseAnchors query_anchor = sigmoid_profile.get_anchors(sigmoid_profile.get_phase(query_time));
+		query_cubics[query_index] = {
+			sigmoid_profile.get_time_jerk(query_anchor.time_phase_begin) / 6,
+			sigmoid_profile.get_time_acceleration(query_anchor.time_phase_begin) / 2,
+			sigmoid_profile.get_time_velocity(query_anchor.time_phase_begin),
+			query_anchor.distance_phase_begin - query_distances[query_index]
+		};
+	}
+
+	// sigmoid profile
+	benchmark_run("sigmoid_construct", regime_name, 1, [&](int query_index) {
+		// query the result so the phase polynomials cannot be optimized away now that construction is inlined
+		return SigmoidMotionProfile(regime.distance_total + query_index * 1e-3f, regime.velocity_max, regime.acceleration_max, regime.jerk).get_time_distance(query_times[query_index]);
+	});
+	benchmark_run("sigmoid_get_time_distance",         regime_name, 1, [&](int query_index) { return sigmoid_profile.get_time_distance(query_times[query_index]); });
+	benchmark_run("sigmoid_get_time_velocity",         regime_name, 1, [&](int query_index) { return sigmoid_profile.get_time_velocity(query_times[query_index]); });
+	benchmark_run("sigmoid_get_time_acceleration",     regime_name, 1, [&](int query_index) { return sigmoid_profile.get_time_acceleration(query_times[query_index]); });
+	benchmark_run("sigmoid_get_time_jerk",             regime_name, 1, [&](int query_index) { return sigmoid_profile.get_time_jerk(query_times[query_index]); });
+	benchmark_run("sigmoid_get_distance_time",         regime_name, 1, [&](int query_index) { return sigmoid_profile.get_distance_time(query_distances[query_index]); });
+	benchmark_run("sigmoid_get_distance_velocity",     regime_name, 1, [&](int query_index) { return sigmoid_profile.get_distance_velocity(query_distances[query_index]); });
+	benchmark_run("sigmoid_get_distance_acceleration", regime_name, 1, [&](int query_index) { return sigmoid_profile.get_distance_acceleration(query_distances[query_index]); });
+	benchmark_run("sigmoid_get_distance_jerk",         regime_name, 1, [&](int query_index) { return sigmoid_profile.get_distance_jerk(query_distances[query_index]); });
+	benchmark_run("sigmoid_get_phase",                 regime_name, 1, [&](int query_index) { return (float) sigmoid_profile.get_phase(query_times[query_index]); });
+	benchmark_run("sigmoid_get_anchors",               regime_name, 1, [&](int query_index) { return sigmoid_profile.get_anchors((SigmoidMotionProfile::SigmoidPhase) (query_index % 7)).distance_phase_end; });
+	benchmark_run("sigmoid_cubic_solve",               regime_name, 1, [&](int query_index) { return sigmoid_cubic_solve(query_cubics[query_index]).roots[0].real(); });
+	benchmark_run("sigmoid_get_time_batch", regime_name, BENCHMARK_QUERY_COUNT, [&](int query_index) {
+		sigmoid_profile.get_time_batch(query_times.data(), BENCHMARK_QUERY_COUNT, query_samples);
+		return query_samples.distance[query_index];
+	});
+	benchmark_run("sigmoid_get_distance_time_batch", regime_name, BENCHMARK_QUERY_COUNT, [&](int query_index) {
+		sigmoid_profile.get_distance_time_batch(query_distances.data(), BENCHMARK_QUERY_COUNT, query_samples.distance);
+		return query_samples.distance[query_index];
+	});
+	MotionProfileCursor sigmoid_cursor = sigmoid_profile.get_cursor(BENCHMARK_TIME_STEP);
+	benchmark_run("sigmoid_cursor_advance", regime_name, 1, [&](int) {
+		if (sigmoid_cursor.is_done()) sigmoid_cursor = sigmoid_profile.get_cursor(BENCHMARK_TIME_STEP);
+		sigmoid_cursor.advance();
+		return sigmoid_cursor.get_sample().distance;
+	});
+
+	// sigmoid profile in double precision
+	BasicSigmoidMotionProfile<double> sigmoid_profile_double = BasicSigmoidMotionProfile<double>(regime.distance_total, regime.velocity_max, regime.acceleration_max, regime.jerk);
+	benchmark_run("sigmoid_double_construct", regime_name, 1, [&](int query_index) {
+		return (float) BasicSigmoidMotionProfile<double>(regime.distance_total + query_index * 1e-3, regime.velocity_max, regime.acceleration_max, regime.jerk).get_time_distance(query_times[query_index]);
+	});
+	benchmark_run("sigmoid_double_get_time_distance", regime_name, 1, [&](int query_index) { return (float) sigmoid_profile_double.get_time_distance(query_times[query_index]); });
+	benchmark_run("sigmoid_double_get_distance_time", regime_name, 1, [&](int query_index) { return (float) sigmoid_profile_double.get_distance_time(query_distances[query_index]); });
+
+	// sigmoid distance table
+	benchmark_realtime = false;
+	benchmark_run("sigmoid_table_construct", regime_name, 1, [&](int) { return (float) SigmoidDistanceTable(sigmoid_profile, 1e-3f).get_report().segment_count; });
+	benchmark_realtime = true;
+	SigmoidDistanceTable sigmoid_table = SigmoidDistanceTable(sigmoid_profile, 1e-3f);
+	benchmark_run("sigmoid_table_get_distance_velocity",     regime_name, 1, [&](int query_index) { return sigmoid_table.get_distance_velocity(query_distances[query_index]); });
+	benchmark_run("sigmoid_table_get_distance_acceleration", regime_name, 1, [&](int query_index) { return sigmoid_table.get_distance_acceleration(query_distances[query_index]); });
+
+	// trapezoidal profile (same distance and limits, jerk unused)
+	TrapezoidalMotionProfile trapezoidal_profile = TrapezoidalMotionProfile(regime.distance_total, regime.velocity_max, regime.acceleration_max);
+	benchmark_run("trapezoidal_construct", regime_name, 1, [&](int query_index) {
+		return TrapezoidalMotionProfile(regime.distance_total + query_index * 1e-3f, regime.velocity_max, regime.acceleration_max).get_distance(query_times[query_index]);
+	});
+	benchmark_run("trapezoidal_get_distance", regime_name, 1, [&](int query_index) { return trapezoidal_profile.get_distance(query_times[query_index]); });
+	benchmark_run("trapezoidal_get_velocity", regime_name, 1, [&](int query_index) { return trapezoidal_profile.get_velocity(query_times[query_index]); });
+	benchmark_run("trapezoidal_get_time_acceleration",     regime_name, 1, [&](int query_index) { return trapezoidal_profile.get_time_acceleration(query_times[query_index]); });
+	benchmark_run("trapezoidal_get_distance_time",         regime_name, 1, [&](int query_index) { return trapezoidal_profile.get_distance_time(query_distances[query_index]); });
+	benchmark_run("trapezoidal_get_distance_velocity",     regime_name, 1, [&](int query_index) { return trapezoidal_profile.get_distance_velocity(query_distances[query_index]); });
+	benchmark_run("trapezoidal_get_distance_acceleration", regime_name, 1, [&](int query_index) { return trapezoidal_profile.get_distance_acceleration(query_distances[query_index]); });
+	benchmark_run("trapezoidal_get_phase",                 regime_name, 1, [&](int query_index) { return (float) trapezoidal_profile.get_phase(query_times[query_index]); });
+	benchmark_run("trapezoidal_get_time_batch", regime_name, BENCHMARK_QUERY_COUNT, [&](int query_index) {
+		trapezoidal_profile.get_time_batch(query_times.data(), BENCHMARK_QUERY_COUNT, query_samples);
+		return query_samples.distance[query_index];
+	});
+	benchmark_run("trapezoidal_get_distance_time_batch", regime_name, BENCHMARK_QUERY_COUNT, [&](int query_index) {
+		trapezoidal_profile.get_distance_time_batch(query_distances.data(), BENCHMARK_QUERY_COUNT, query_samples.distance);
+		return query_samples.distance[query_index];
+	});
+	MotionProfileCursor trapezoidal_cursor = trapezoidal_profile.get_cursor(BENCHMARK_TIME_STEP);
+	benchmark_run("trapezoidal_cursor_advance", regime_name, 1, [&](int) {
+		if (trapezoidal_cursor.is_done()) trapezoidal_cursor = trapezoidal_profile.get_cursor(BENCHMARK_TIME_STEP);
+		trapezoidal_cursor.advance();
+		return trapezoidal_cursor.get_sample().distance;
+	});
+
+	// fixed point backend
+	benchmark_fixed("sigmoid",     regime_name, sigmoid_profile.get_segments(),     7, sigmoid_time_end);
+	benchmark_fixed("trapezoidal", regime_name, trapezoidal_profile.get_segments(), 3, trapezoidal_profile.get_time());
+}
+
+// pool sizes a parallel path is measured at: 1, 2, 4 and every hardware thread, each once (result names stay unique)
+std::vector<int> benchmark_thread_counts() {
+	std::vector<int> thread_counts = {1, 2, 4, std::max((int) std::thread::hardware_concurrency(), 1)};
+	std::sort(thread_counts.begin(), thread_counts.end());
+	thread_counts.erase(std::unique(thread_counts.begin(), thread_counts.end()), thread_counts.end());
+	return thread_counts;
+}
+
+// six axes of one move: the long axis sets the duration, the others (one of them idle) are stretched to it
+const SigmoidAxisLimits benchmark_axis_limits[6] = {
+	{300.0f, 50.0f, 5.0f, 2.0f}, {-100.0f, 50.0f, 5.0f, 2.0f}, {20.0f, 10.0f, 5.0f, 2.0f},
+	{0.0f,   50.0f, 5.0f, 2.0f}, {-40.0f,  30.0f, 5.0f, 2.0f}, {1.0f,   20.0f, 10.0f, 50.0f}
+};
+
+void benchmark_multi_axis() {
+	const char*             regime_name       = "six_axis";
+	SigmoidMultiAxisProfile multi_axis_profile = SigmoidMultiAxisProfile(benchmark_axis_limits, 6);
+	float                   time_end           = multi_axis_profile.get_time_end();
+	float                   axis_outputs[4][SIGMOID_MULTI_AXIS_COUNT_MAX];
+	MotionProfileSamples    axis_samples       = {axis_outputs[0], axis_outputs[1], axis_outputs[2], axis_outputs[3]};
+	benchmark_run("sigmoid_multi_axis_construct", regime_name, 1, [&](int query_index) {
+		SigmoidAxisLimits axis_limits[6];
+		for (int axis_index = 0; axis_index < 6; axis_index++) axis_limits[axis_index] = benchmark_axis_limits[axis_index];
+		axis_limits[0].distance += query_index * 1e-3f;
+		return SigmoidMultiAxisProfile(axis_limits, 6).get_time_end();
+	});
+	benchmark_run("sigmoid_multi_axis_get_time_samples", regime_name, 1, [&](int query_index) {
+		multi_axis_profile.get_time_samples(time_end * query_index / (BENCHMARK_QUERY_COUNT - 1), axis_samples);
+		return axis_samples.distance[query_index % 6];
+	});
+	// a batch of moves planned over pools of growing size (items are moves)
+	std::vector<SigmoidAxisLimits>       move_axis_limits(BENCHMARK_PLAN_MOVES * 6);
+	std::vector<SigmoidMultiAxisProfile> move_profiles(BENCHMARK_PLAN_MOVES);
+	for (int move_index = 0; move_index < BENCHMARK_PLAN_MOVES; move_index++) {
+		for (int axis_index = 0; axis_index < 6; axis_index++) {
+			move_axis_limits[move_index * 6 + axis_index]           = benchmark_axis_limits[axis_index];
+			move_axis_limits[move_index * 6 + axis_index].distance *= 1.0f + (move_index % 97) * 0.01f;
+		}
+	}
+	for (int thread_count : benchmark_thread_counts()) {
+		MotionProfileThreadPool thread_pool    = MotionProfileThreadPool(thread_count);
+		std::string             benchmark_name = "sigmoid_multi_axis_plan_batch_threads_" + std::to_string(thread_pool.get_thread_count());
+		benchmark_run(benchmark_name.c_str(), regime_name, BENCHMARK_PLAN_MOVES, [&](int query_index) {
+			sigmoid_multi_axis_plan_batch(thread_pool, move_axis_limits.data(), 6, BENCHMARK_PLAN_MOVES, move_profiles.data());
+			return move_profiles[query_index].get_time_end();
+		});
+	}
+}
+
+// a working set of moves that fits the cache (every lookup after the first pass hits) and one that does not (every
+// lookup misses and evicts), against building the profile directly
+void benchmark_cache() {
+	const char*               regime_name         = "moves_256";
+	SigmoidMotionProfileCache profile_cache       = SigmoidMotionProfileCache(BENCHMARK_CACHE_MOVES);
+	SigmoidMotionProfileCache profile_cache_small = SigmoidMotionProfileCache(BENCHMARK_CACHE_MOVES / 2);
+	benchmark_run("sigmoid_construct_uncached", regime_name, 1, [&](int query_index) {
+		return SigmoidMotionProfile(100.0f + (query_index % BENCHMARK_CACHE_MOVES) * 0.5f, 50.0f, 5.0f, 2.0f).get_time_distance(1.0f);
+	});
+	benchmark_run("sigmoid_cache_get_profile_hit", regime_name, 1, [&](int query_index) {
+		return profile_cache.get_profile(100.0f + (query_index % BENCHMARK_CACHE_MOVES) * 0.5f, 50.0f, 5.0f, 2.0f)->get_time_distance(1.0f);
+	});
+	benchmark_run("sigmoid_cache_get_profile_miss", regime_name, 1, [&](int query_index) {
+		return profile_cache_small.get_profile(100.0f + (query_index % BENCHMARK_CACHE_MOVES) * 0.5f, 50.0f, 5.0f, 2.0f)->get_time_distance(1.0f);
+	});
+	SigmoidMotionProfileCache::SigmoidCacheCounters cache_counters = profile_cache.get_counters();
+	fprintf(stderr, "cache hits %llu misses %llu evictions %llu\n", cache_counters.hit_count, cache_counters.miss_count, cache_counters.eviction_count);
+}
+
+// latency of single replans from random states (over the velocity and acceleration limits too, moving away from the
+// target, already at it), each timed on its own. every state is replanned a few times and its fastest run is kept, which
+// filters out preemption but not slow paths. percentiles go to the results, the histogram to stderr
+void benchmark_replan() {
+	const char*                                           regime_name    = "random_state";
+	std::mt19937                                          state_random   = std::mt19937(11);
+	std::uniform_real_distribution<float>                 state_uniform  = std::uniform_real_distribution<float>(-1.0f, 1.0f);
+	std::vector<SigmoidReplanProfile::SigmoidMotionState> replan_states  = std::vector<SigmoidReplanProfile::SigmoidMotionState>(BENCHMARK_REPLANS);
+	std::vector<float>                                    replan_targets = std::vector<float>(BENCHMARK_REPLANS);
+	for (int replan_index = 0; replan_index < BENCHMARK_REPLANS; replan_index++) {
+		replan_states[replan_index]  = {100.0f * state_uniform(state_random), 65.0f * state_uniform(state_random), 6.0f * state_uniform(state_random)};
+		replan_targets[replan_index] = (replan_index % 16 == 0 ? replan_states[replan_index].distance : 300.0f * state_uniform(state_random));
+	}
+	std::vector<double> replan_latencies = std::vector<double>(BENCHMARK_REPLANS, std::numeric_limits<double>::infinity());
+	float               value_sink       = 0.0f;
+	long long           allocation_count = benchmark_allocation_count.load(std::memory_order_relaxed);
+	for (int repetition = 0; repetition < BENCHMARK_REPETITIONS; repetition++) {
+		for (int replan_index = 0; replan_index < BENCHMARK_REPLANS; replan_index++) {
+			std::chrono::steady_clock::time_point time_begin = std::chrono::steady_clock::now();
+			SigmoidReplanProfile replan_profile = SigmoidReplanProfile(replan_states[replan_index], replan_targets[replan_index], 50.0f, 5.0f, 2.0f);
+			value_sink += replan_profile.get_segments()[replan_profile.get_segment_count() - 1].cubic_degree_zero;
+			replan_latencies[replan_index] = std::min(replan_latencies[replan_index], std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - time_begin).count());
+		}
+	}
+	benchmark_sink   = value_sink;
+	allocation_count = benchmark_allocation_count.load(std::memory_order_relaxed) - allocation_count;
+	std::sort(replan_latencies.begin(), replan_latencies.end());
+	const char* percentile_names[4]  = {"sigmoid_replan_latency_p50", "sigmoid_replan_latency_p99", "sigmoid_replan_latency_p999", "sigmoid_replan_latency_max"};
+	double      percentile_values[4] = {0.5, 0.99, 0.999, 1.0};
+	for (int percentile_index = 0; percentile_index < 4; percentile_index++) {
+		size_t latency_index = std::min((size_t) (percentile_values[percentile_index] * BENCHMARK_REPLANS), (size_t) BENCHMARK_REPLANS - 1);
+		benchmark_results.push_back({percentile_names[percentile_index], regime_name, replan_latencies[latency_index], BENCHMARK_REPLANS, (double) allocation_count / ((double) BENCHMARK_REPLANS * BENCHMARK_REPETITIONS), true});
+		fprintf(stderr, "%-44s %-10s %10.2f ns/op\n", percentile_names[percentile_index], regime_name, replan_latencies[latency_index]);
+	}
+	// power of two buckets (timer overhead included)
+	int latency_buckets[24] = {};
+	for (double latency : replan_latencies) latency_buckets[std::min((int) std::log2(std::max(latency, 1.0)), 23)]++;
+	for (int bucket_index = 0; bucket_index < 24; bucket_index++) {
+		if (latency_buckets[bucket_index] > 0) fprintf(stderr, "  replan latency < %8d ns: %d\n", 2 << bucket_index, latency_buckets[bucket_index]);
+	}
+}
+
+const char* benchmark_kernel_name(MotionProfileBatchKernel batch_kernel) {
+	switch (batch_kernel) {
+		case MotionProfileBatchKernel::AVX2:  return "avx2";
+		case MotionProfileBatchKernel::SSE41: return "sse4.1";
+		default:                              return "scalar";
+	}
+}
+
+// durations of many limit sets (items are moves), from the profile, the closed form alone and the batch on every
+// supported kernel it implements. every batch is checked against get_time_end
+void benchmark_duration() {
+	const char*                           regime_name    = "moves_1024";
+	std::mt19937                          limit_random   = std::mt19937(7);
+	std::uniform_real_distribution<float> limit_uniform  = std::uniform_real_distribution<float>(0.0f, 1.0f);
+	std::vector<float>                    limit_columns[4];
+	for (std::vector<float>& limit_column : limit_columns) limit_column.resize(BENCHMARK_DURATION_MOVES);
+	for (int move_index = 0; move_index < BENCHMARK_DURATION_MOVES; move_index++) {
+		limit_columns[0][move_index] = 1.0f + 400.0f * limit_uniform(limit_random);
+		limit_columns[1][move_index] = 5.0f + 50.0f * limit_uniform(limit_random);
+		limit_columns[2][move_index] = 1.0f + 10.0f * limit_uniform(limit_random);
+		limit_columns[3][move_index] = 0.5f + 5.0f * limit_uniform(limit_random);
+	}
+	SigmoidLimitColumns    move_limits    = {limit_columns[0].data(), limit_columns[1].data(), limit_columns[2].data(), limit_columns[3].data()};
+	std::vector<float>     time_ends      = std::vector<float>(BENCHMARK_DURATION_MOVES);
+	SigmoidDurationColumns move_durations = {nullptr, nullptr, nullptr, time_ends.data()};
+	benchmark_run("sigmoid_construct_time_end", regime_name, BENCHMARK_DURATION_MOVES, [&](int) {
+		float time_sum = 0.0f;
+		for (int move_index = 0; move_index < BENCHMARK_DURATION_MOVES; move_index++) time_sum += SigmoidMotionProfile(move_limits.distance_total[move_index], move_limits.velocity_max[move_index], move_limits.acceleration_max[move_index], move_limits.jerk[move_index]).get_time_end();
+		return time_sum;
+	});
+	benchmark_run("sigmoid_phase_durations", regime_name, BENCHMARK_DURATION_MOVES, [&](int) {
+		float time_sum = 0.0f;
+		for (int move_index = 0; move_index < BENCHMARK_DURATION_MOVES; move_index++) {
+			SigmoidPhaseDurations<float> phase_durations = sigmoid_phase_durations(move_limits.distance_total[move_index], move_limits.velocity_max[move_index], move_limits.acceleration_max[move_index], move_limits.jerk[move_index]);
+			time_sum += 4 * phase_durations.time_accelerate + 2 * phase_durations.time_retain + phase_durations.time_drift;
+		}
+		return time_sum;
+	});
+	for (int kernel_index = 0; kernel_index <= (int) motion_profile_batch_kernel_supported(); kernel_index++) {
+		// kernels that fall back to another one are not measured again under their own name
+		MotionProfileBatchKernel batch_kernel   = (MotionProfileBatchKernel) kernel_index;
+		if (sigmoid_duration_batch_kernel(batch_kernel) != batch_kernel) continue;
+		std::string              benchmark_name = std::string("sigmoid_duration_batch_") + benchmark_kernel_name(batch_kernel);
+		benchmark_run(benchmark_name.c_str(), regime_name, BENCHMARK_DURATION_MOVES, [&](int query_index) {
+			sigmoid_duration_batch(move_limits, BENCHMARK_DURATION_MOVES, move_durations, batch_kernel);
+			return time_ends[query_index];
+		});
+		double error_relative = 0.0;
+		for (int move_index = 0; move_index < BENCHMARK_DURATION_MOVES; move_index++) {
+			float time_end = SigmoidMotionProfile(move_limits.distance_total[move_index], move_limits.velocity_max[move_index], move_limits.acceleration_max[move_index], move_limits.jerk[move_index]).get_time_end();
+			error_relative = std::max(error_relative, (double) std::fabs(time_ends[move_index] - time_end) / time_end);
+		}
+		fprintf(stderr, "%-44s %-10s end time deviation from the profiles %.3g\n", benchmark_name.c_str(), regime_name, error_relative);
+	}
+}
+
+// a path of short uneven legs, appended waypoint by waypoint (items are waypoints) and then queried
+void benchmark_trajectory() {
+	const char*                                              regime_name          = "waypoints_512";
+	std::vector<MotionProfileTrajectory::TrajectoryWaypoint> trajectory_waypoints = std::vector<MotionProfileTrajectory::TrajectoryWaypoint>(BENCHMARK_WAYPOINTS);
+	float waypoint_distance = 0.0f;
+	for (int waypoint_index = 0; waypoint_index < BENCHMARK_WAYPOINTS; waypoint_index++) {
+		waypoint_distance += 1.0f + (waypoint_index * 7919 % 13) * 0.5f;
+		trajectory_waypoints[waypoint_index] = {waypoint_distance, 30.0f, 50.0f, 5.0f, 20.0f};
+	}
+	MotionProfileTrajectory trajectory = MotionProfileTrajectory();
+	for (const MotionProfileTrajectory::TrajectoryWaypoint& waypoint : trajectory_waypoints) trajectory.append_waypoint(waypoint);
+	float time_end = trajectory.get_time_end();
+	benchmark_run("trajectory_append_waypoint", regime_name, BENCHMARK_WAYPOINTS, [&](int query_index) {
+		MotionProfileTrajectory trajectory_built = MotionProfileTrajectory(query_index * 1e-3f);
+		for (const MotionProfileTrajectory::TrajectoryWaypoint& waypoint : trajectory_waypoints) trajectory_built.append_waypoint(waypoint);
+		return trajectory_built.get_time_end();
+	});
+	benchmark_run("trajectory_get_time_distance", regime_name, 1, [&](int query_index) {
+		return trajectory.get_time_distance(time_end * query_index / (BENCHMARK_QUERY_COUNT - 1));
+	});
+	benchmark_run("trajectory_get_distance_time", regime_name, 1, [&](int query_index) {
+		return trajectory.get_distance_time(waypoint_distance * query_index / (BENCHMARK_QUERY_COUNT - 1));
+	});
+}
+
+// bulk generation into a file over pools of growing size, then reading it back through the mapping (items are samples).
+// the generated file is checked against the profiles it was built from
+void benchmark_bulk() {
+	const char*                       regime_name = "moves_256";
+	std::string                       bulk_path   = (std::filesystem::temp_directory_path() / "motion_profile_benchmark.bulk").string();
+	std::vector<MotionProfileBulkJob> bulk_jobs   = std::vector<MotionProfileBulkJob>(BENCHMARK_BULK_MOVES);
+	for (int move_index = 0; move_index < BENCHMARK_BULK_MOVES; move_index++) {
+		bulk_jobs[move_index] = {(move_index % 2 == 0 ? MotionProfileBulkKind::SIGMOID : MotionProfileBulkKind::TRAPEZOIDAL), 1.0f + (move_index % 37) * 0.25f, 5.0f, 10.0f, 50.0f};
+	}
+	MotionProfileBulkFile bulk_file = MotionProfileBulkFile();
+	{
+		MotionProfileThreadPool thread_pool = MotionProfileThreadPool(1);
+		if (motion_profile_bulk_write(thread_pool, bulk_jobs.data(), bulk_jobs.size(), BENCHMARK_TIME_STEP, bulk_path.c_str()) != MotionProfileBulkStatus::OK || bulk_file.open(bulk_path.c_str()) != MotionProfileBulkStatus::OK) {
+			fprintf(stderr, "cannot write %s\n", bulk_path.c_str());
+			return;
+		}
+	}
+	int sample_count = (int) bulk_file.get_header().sample_count;
+	for (int thread_count : benchmark_thread_counts()) {
+		MotionProfileThreadPool thread_pool    = MotionProfileThreadPool(thread_count);
+		std::string             benchmark_name = "bulk_write_threads_" + std::to_string(thread_pool.get_thread_count());
+		benchmark_run(benchmark_name.c_str(), regime_name, sample_count, [&](int) {
+			return (float) motion_profile_bulk_write(thread_pool, bulk_jobs.data(), bulk_jobs.size(), BENCHMARK_TIME_STEP, bulk_path.c_str());
+		});
+	}
+	bulk_file.open(bulk_path.c_str());
+	benchmark_run("bulk_read_distance", regime_name, sample_count, [&](int) {
+		const float* distances    = bulk_file.get_column(MotionProfileBulkColumn::DISTANCE);
+		float        distance_sum = 0.0f;
+		for (int sample_index = 0; sample_index < sample_count; sample_index++) distance_sum += distances[sample_index];
+		return distance_sum;
+	});
+	double error_distance = 0.0;
+	for (size_t move_index = 0; move_index < bulk_file.get_move_count(); move_index++) {
+		const MotionProfileBulkMove& move      = bulk_file.get_move(move_index);
+		const float*                 times     = bulk_file.get_move_column(move_index, MotionProfileBulkColumn::TIME);
+		const float*                 distances = bulk_file.get_move_column(move_index, MotionProfileBulkColumn::DISTANCE);
+		for (uint64_t sample_index = 0; sample_index < move.sample_count; sample_index++) {
+			float distance_expected = (move.job.kind == MotionProfileBulkKind::SIGMOID
+				? SigmoidMotionProfile(move.job.distance, move.job.velocity_max, move.job.acceleration_max, move.job.jerk).get_time_distance(times[sample_index])
+				: TrapezoidalMotionProfile(move.job.distance, move.job.velocity_max, move.job.acceleration_max).get_distance(times[sample_index]));
+			error_distance = std::max(error_distance, (double) std::fabs(distances[sample_index] - distance_expected));
+		}
+	}
+	fprintf(stderr, "bulk file moves %zu samples %d bytes %llu, distance deviation from the profiles %.3g\n",
+		bulk_file.get_move_count(), sample_count, (unsigned long long) bulk_file.get_header().file_bytes, error_distance);
+	bulk_file.close();
+	std::filesystem::remove(bulk_path);
+}
+
+// setpoints through the ring: first as fast as both threads go (every setpoint is checked to come out once and in
+// order), then paced by a control loop ticking at 1 to 10 khz against a planner chaining sigmoid and trapezoidal moves.
+// the paced runs report how late the control thread woke (jitter) and how long its pop took, percentiles over all ticks
+void benchmark_stream() {
+	{
+		MotionProfileSetpointRing setpoint_ring = MotionProfileSetpointRing();
+		std::chrono::steady_clock::time_point time_begin = std::chrono::steady_clock::now();
+		std::thread producer_thread = std::thread([&]() {
+			for (int setpoint_index = 0; setpoint_index < BENCHMARK_STREAM_SETPOINTS;) {
+				if (setpoint_ring.push({(float) setpoint_index, 0.0f, 0.0f, 0.0f})) setpoint_index++;
+				else std::this_thread::yield();
+			}
+			setpoint_ring.finish();
+		});
+		MotionProfileSetpoint     setpoint;
+		MotionProfileStreamStatus stream_status;
+		int                       setpoint_expected = 0;
+		while ((stream_status = setpoint_ring.pop(setpoint)) != MotionProfileStreamStatus::FINISHED) {
+			if (stream_status == MotionProfileStreamStatus::UNDERRUN) {
+				std::this_thread::yield();
+				continue;
+			}
+			if (setpoint.time != (float) setpoint_expected) benchmark_stream_violations++;
+			setpoint_expected++;
+		}
+		producer_thread.join();
+		if (setpoint_expected != BENCHMARK_STREAM_SETPOINTS) benchmark_stream_violations++;
+		double ns_per_op = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - time_begin).count() / BENCHMARK_STREAM_SETPOINTS;
+		benchmark_results.push_back({"stream_push_pop", "unpaced", ns_per_op, BENCHMARK_STREAM_SETPOINTS, 0.0, false});
+		MotionProfileSetpointRing::StreamCounters stream_counters = setpoint_ring.get_counters();
+		fprintf(stderr, "%-44s %-10s %10.2f ns/op, refused %llu underruns %llu out of order %d\n", "stream_push_pop", "unpaced", ns_per_op, stream_counters.push_refused_count, stream_counters.underrun_count, benchmark_stream_violations);
+	}
+	int tick_rates[4] = {1000, 2000, 5000, 10000};
+	for (int tick_rate : tick_rates) {
+		std::string               regime_name   = "rate_" + std::to_string(tick_rate) + "_hz";
+		float                     time_step     = 1.0f / tick_rate;
+		int                       tick_count    = (int) (BENCHMARK_STREAM_SECONDS * tick_rate);
+		MotionProfileSetpointRing setpoint_ring = MotionProfileSetpointRing(BENCHMARK_STREAM_CAPACITY);
+		std::atomic<bool>         producer_stop = false;
+		std::thread producer_thread = std::thread([&]() {
+			// moves are chained end to end, the planner sleeps while the ring is full
+			SigmoidMotionProfile     sigmoid_profile     = SigmoidMotionProfile(0.5f, 2.0f, 10.0f, 50.0f);
+			TrapezoidalMotionProfile trapezoidal_profile = TrapezoidalMotionProfile(0.5f, 2.0f, 10.0f);
+			int                      move_index          = 0;
+			float                    time_offset         = 0.0f;
+			float                    position_offset     = 0.0f;
+			MotionProfileCursor      cursor              = sigmoid_profile.get_cursor(time_step);
+			while (!producer_stop.load(std::memory_order_relaxed)) {
+				if (cursor.is_done()) {
+					time_offset     += cursor.get_sample().time + time_step;
+					position_offset += cursor.get_sample().distance;
+					cursor           = (++move_index % 2 == 0 ? sigmoid_profile.get_cursor(time_step) : trapezoidal_profile.get_cursor(time_step));
+				}
+				if (motion_profile_stream_feed(setpoint_ring, cursor, time_offset, position_offset) == 0) {
+					std::this_thread::sleep_for(std::chrono::duration<double>((double) time_step * BENCHMARK_STREAM_CAPACITY / 4));
+				}
+			}
+			setpoint_ring.finish();
+		});
+		std::vector<double>   tick_jitters  = std::vector<double>(tick_count);
+		std::vector<double>   pop_latencies = std::vector<double>(tick_count);
+		MotionProfileSetpoint setpoint      = {};
+		float                 value_sink    = 0.0f;
+		// let the planner fill the ring before the first tick
+		std::this_thread::sleep_for(std::chrono::milliseconds(10));
+		long long allocation_count = benchmark_allocation_count.load(std::memory_order_relaxed);
+		std::chrono::steady_clock::time_point time_begin = std::chrono::steady_clock::now();
+		for (int tick_index = 0; tick_index < tick_count; tick_index++) {
+			std::chrono::steady_clock::time_point tick_deadline = time_begin + std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>((double) tick_index / tick_rate));
+			std::this_thread::sleep_until(tick_deadline);
+			std::chrono::steady_clock::time_point tick_wake = std::chrono::steady_clock::now();
+			MotionProfileStreamStatus stream_status = setpoint_ring.pop(setpoint);
+			std::chrono::steady_clock::time_point tick_popped = std::chrono::steady_clock::now();
+			if (stream_status == MotionProfileStreamStatus::SETPOINT) value_sink += setpoint.position;
+			tick_jitters[tick_index]  = std::chrono::duration<double, std::nano>(tick_wake - tick_deadline).count();
+			pop_latencies[tick_index] = std::chrono::duration<double, std::nano>(tick_popped - tick_wake).count();
+		}
+		allocation_count = benchmark_allocation_count.load(std::memory_order_relaxed) - allocation_count;
+		producer_stop.store(true, std::memory_order_relaxed);
+		producer_thread.join();
+		benchmark_sink = value_sink;
+		std::sort(tick_jitters.begin(), tick_jitters.end());
+		std::sort(pop_latencies.begin(), pop_latencies.end());
+		const char* percentile_names[2][3] = {{"stream_tick_jitter_p50", "stream_tick_jitter_p99", "stream_tick_jitter_max"}, {"stream_pop_latency_p50", "stream_pop_latency_p99", "stream_pop_latency_max"}};
+		double      percentile_values[3]   = {0.5, 0.99, 1.0};
+		for (int series_index = 0; series_index < 2; series_index++) {
+			const std::vector<double>& series = (series_index == 0 ? tick_jitters : pop_latencies);
+			for (int percentile_index = 0; percentile_index < 3; percentile_index++) {
+				size_t latency_index = std::min((size_t) (percentile_values[percentile_index] * tick_count), (size_t) tick_count - 1);
+				benchmark_results.push_back({percentile_names[series_index][percentile_index], regime_name, series[latency_index], tick_count, (double) allocation_count / tick_count, series_index == 1});
+				fprintf(stderr, "%-44s %-10s %10.2f ns/op\n", percentile_names[series_index][percentile_index], regime_name.c_str(), series[latency_index]);
+			}
+		}
+		MotionProfileSetpointRing::StreamCounters stream_counters = setpoint_ring.get_counters();
+		fprintf(stderr, "stream %s pushed %llu popped %llu refused %llu underruns %llu occupancy max %zu\n", regime_name.c_str(),
+			stream_counters.push_count, stream_counters.pop_count, stream_counters.push_refused_count, stream_counters.underrun_count, stream_counters.occupancy_max);
+	}
+}
+
+// summary of what the instrumented library recorded over the whole run (empty unless built with the instrumentation)
+void benchmark_instrumentation() {
+	MotionProfileInstrumentationSnapshot instrumentation_snapshot = motion_profile_instrumentation_snapshot();
+	for (int api_index = 0; api_index < (int) MotionProfileApi::COUNT; api_index++) {
+		const MotionProfileInstrumentationSnapshot::ApiStats& api_stats = instrumentation_snapshot.api_stats[api_index];
+		if (api_stats.call_count == 0) continue;
+		fprintf(stderr, "%-44s calls %12llu mean %8.2f ns\n", motion_profile_api_name((MotionProfileApi) api_index), api_stats.call_count, (double) api_stats.time_total_ns / api_stats.call_count);
+	}
+	for (int branch_index = 0; branch_index < (int) MotionProfileSolverBranch::COUNT; branch_index++) {
+		if (instrumentation_snapshot.solver_branch_counts[branch_index] == 0) continue;
+		fprintf(stderr, "%-44s count %12llu\n", motion_profile_solver_branch_name((MotionProfileSolverBranch) branch_index), instrumentation_snapshot.solver_branch_counts[branch_index]);
+	}
+	if (instrumentation_snapshot.residual_count > 0) {
+		fprintf(stderr, "%-44s count %12llu max %.3g\n", "distance_time_residual", instrumentation_snapshot.residual_count, instrumentation_snapshot.residual_max);
+	}
+}
+
+// usage: motion_profile_benchmark [output.json]   (json goes to stdout without a path, progress to stderr)
+int main(int argc, char** argv) {
+	benchmark_realtime = true;
+	for (const BenchmarkRegime& regime : benchmark_regimes) benchmark_regime(regime);
+	benchmark_realtime = false;
+	benchmark_multi_axis();
+	benchmark_duration();
+	benchmark_trajectory();
+	benchmark_cache();
+	benchmark_replan();
+	benchmark_bulk();
+	benchmark_stream();
+	benchmark_instrumentation();
+	FILE* output_file = (argc > 1 ? fopen(argv[1], "w") : stdout);
+	if (output_file == nullptr) {
+		fprintf(stderr, "cannot open %s\n", argv[1]);
+		return 1;
+	}
+	fprintf(output_file, "{\n  \"batch_kernel\": \"%s\",\n  \"benchmarks\": [\n", benchmark_kernel_name(motion_profile_batch_kernel_supported()));
+	for (size_t result_index = 0; result_index < benchmark_results.size(); result_index++) {
+		const BenchmarkResult& result = benchmark_results[result_index];
+		fprintf(output_file, "    {\"name\": \"%s\", \"regime\": \"%s\", \"ns_per_op\": %.3f, \"ops_per_second\": %.1f, \"iterations\": %lld, \"allocations_per_op\": %.3f}%s\n",
+			result.benchmark_name.c_str(), result.regime_name.c_str(), result.ns_per_op, 1e9 / result.ns_per_op, result.iterations, result.allocations_per_op,
+			(result_index + 1 < benchmark_results.size() ? "," : ""));
+	}
+	fprintf(output_file, "  ],\n  \"accuracy\": [\n");
+	for (size_t accuracy_index = 0; accuracy_index < benchmark_accuracies.size(); accuracy_index++) {
+		const BenchmarkAccuracy& accuracy = benchmark_accuracies[accuracy_index];
+		fprintf(output_file, "    {\"name\": \"%s\", \"regime\": \"%s\", \"error_distance\": %.3e, \"error_velocity\": %.3e, \"error_acceleration\": %.3e, \"bound_distance\": %.3e, \"bound_velocity\": %.3e, \"bound_acceleration\": %.3e}%s\n",
+			accuracy.benchmark_name.c_str(), accuracy.regime_name.c_str(), accuracy.error_max[0], accuracy.error_max[1], accuracy.error_max[2],
+			accuracy.error_bound[0], accuracy.error_bound[1], accuracy.error_bound[2], (accuracy_index + 1 < benchmark_accuracies.size() ? "," : ""));
+	}
+	fprintf(output_file, "  ]\n}\n");
+	if (output_file != stdout) fclose(output_file);
+	// the real time api must not allocate, on construction or on any query
+	int realtime_allocating = 0;
+	for (const BenchmarkResult& result : benchmark_results) {
+		if (!result.realtime || result.allocations_per_op == 0.0) continue;
+		fprintf(stderr, "%s (%s) allocates %.3f times per op\n", result.benchmark_name.c_str(), result.regime_name.c_str(), result.allocations_per_op);
+		realtime_allocating++;
+	}
+	// and a backend must stay inside its documented error bound
+	int accuracy_exceeded = 0;
+	for (const BenchmarkAccuracy& accuracy : benchmark_accuracies) {
+		for (int value_index = 0; value_index < 3; value_index++) {
+			if (accuracy.error_bound[value_index] < 0 || accuracy.error_max[value_index] <= accuracy.error_bound[value_index]) continue;
+			fprintf(stderr, "%s (%s) exceeds its error bound\n", accuracy.benchmark_name.c_str(), accuracy.regime_name.c_str());
+			accuracy_exceeded++;
+		}
+	}
+	if (realtime_allocating > 0) return 2;
+	if (accuracy_exceeded > 0) return 3;
+	// and the setpoint ring must hand out every setpoint once, in order
+	return (benchmark_stream_violations > 0 ? 4 : 0);
+}
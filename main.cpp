@@ -3,7 +3,7 @@
 #include "motion_profile_sigmoid/motion_profile_sigmoid.h"
 
 // parameters: [distance_total, velocity_max, acceleration_max, jerk]
-SigmoidMotionProfile motion_profile = SigmoidMotionProfile(300, 50, 5, 2);
+constexpr SigmoidMotionProfile motion_profile = SigmoidMotionProfile(300, 50, 5, 2); // solved at compile time
 
 int main() {
     float time_full = motion_profile.get_time_end();
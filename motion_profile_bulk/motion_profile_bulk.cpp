@@ -0,0 +1,226 @@
+#include <cmath>
+#include <cstring>
+#include <vector>
+#include <algorithm>
+#if defined(_WIN32)
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+#include "motion_profile_bulk.h"
+#include "../motion_profile_sigmoid/motion_profile_sigmoid.h"
+#include "../motion_profile_trapezoidal/motion_profile_trapezoidal.h"
+
+const char motion_profile_bulk_magic[8] = {'M', 'P', 'B', 'U', 'L', 'K', 0, 0};
+
+// a planned move: its segment table and the end of the motion
+struct MotionProfileBulkPlan {
+	MotionProfileSegment segments[7];
+	int                  segment_count;
+	float                time_end;
+};
+
+template <MotionProfileShape Profile>
+MotionProfileBulkPlan motion_profile_bulk_plan(const Profile& motion_profile) {
+	MotionProfileBulkPlan move_plan = {};
+	move_plan.segment_count         = std::min(motion_profile.get_segment_count(), 7);
+	move_plan.time_end              = motion_profile.get_time_end();
+	std::copy(motion_profile.get_segments(), motion_profile.get_segments() + move_plan.segment_count, move_plan.segments);
+	return move_plan;
+}
+
+uint64_t motion_profile_bulk_align(uint64_t offset) {
+	return (offset + MOTION_PROFILE_BULK_ALIGNMENT - 1) / MOTION_PROFILE_BULK_ALIGNMENT * MOTION_PROFILE_BULK_ALIGNMENT;
+}
+
+// maps a file shared, either created (or truncated) at file_bytes for writing, or whole for reading. the file handle is
+// not needed once the mapping exists
+void* motion_profile_bulk_map(const char* path, bool map_writable, size_t& file_bytes, MotionProfileBulkStatus& status) {
+#if defined(_WIN32)
+	HANDLE file_handle = CreateFileA(path, map_writable ? (GENERIC_READ | GENERIC_WRITE) : GENERIC_READ, FILE_SHARE_READ, nullptr, map_writable ? CREATE_ALWAYS : OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+	if (file_handle == INVALID_HANDLE_VALUE) {
+		status = MotionProfileBulkStatus::FILE_FAILED;
+		return nullptr;
+	}
+	LARGE_INTEGER file_size = {};
+	file_size.QuadPart      = (LONGLONG) file_bytes;
+	bool file_sized = (map_writable ? SetFilePointerEx(file_handle, file_size, nullptr, FILE_BEGIN) && SetEndOfFile(file_handle) : GetFileSizeEx(file_handle, &file_size));
+	if (!file_sized) {
+		CloseHandle(file_handle);
+		status = MotionProfileBulkStatus::FILE_FAILED;
+		return nullptr;
+	}
+	file_bytes = (size_t) file_size.QuadPart;
+	if (file_bytes == 0) {
+		CloseHandle(file_handle);
+		status = MotionProfileBulkStatus::INVALID_FILE;
+		return nullptr;
+	}
+	HANDLE mapping_handle  = CreateFileMappingA(file_handle, nullptr, map_writable ? PAGE_READWRITE : PAGE_READONLY, 0, 0, nullptr);
+	void*  mapping_address = (mapping_handle != nullptr ? MapViewOfFile(mapping_handle, map_writable ? FILE_MAP_WRITE : FILE_MAP_READ, 0, 0, file_bytes) : nullptr);
+	if (mapping_handle != nullptr) CloseHandle(mapping_handle);
+	CloseHandle(file_handle);
+#else
+	// a replaced file is unlinked rather than truncated: readers still mapping it keep their copy, and the file system
+	// does not have to flush the old pages first
+	if (map_writable) ::unlink(path);
+	int file_descriptor = ::open(path, map_writable ? (O_RDWR | O_CREAT | O_TRUNC) : O_RDONLY, 0644);
+	if (file_descriptor < 0) {
+		status = MotionProfileBulkStatus::FILE_FAILED;
+		return nullptr;
+	}
+	struct stat file_stat = {};
+	bool file_sized = (map_writable ? ftruncate(file_descriptor, (off_t) file_bytes) == 0 : fstat(file_descriptor, &file_stat) == 0);
+	if (!file_sized) {
+		::close(file_descriptor);
+		status = MotionProfileBulkStatus::FILE_FAILED;
+		return nullptr;
+	}
+	if (!map_writable) file_bytes = (size_t) file_stat.st_size;
+	if (file_bytes == 0) {
+		::close(file_descriptor);
+		status = MotionProfileBulkStatus::INVALID_FILE;
+		return nullptr;
+	}
+	void* mapping_address = mmap(nullptr, file_bytes, map_writable ? (PROT_READ | PROT_WRITE) : PROT_READ, MAP_SHARED, file_descriptor, 0);
+	::close(file_descriptor);
+	if (mapping_address == MAP_FAILED) mapping_address = nullptr;
+#endif
+	status = (mapping_address != nullptr ? MotionProfileBulkStatus::OK : MotionProfileBulkStatus::MAPPING_FAILED);
+	return mapping_address;
+}
+
+void motion_profile_bulk_unmap(void* mapping_address, size_t mapping_bytes) {
+#if defined(_WIN32)
+	(void) mapping_bytes;
+	UnmapViewOfFile(mapping_address);
+#else
+	munmap(mapping_address, mapping_bytes);
+#endif
+}
+
+MotionProfileBulkStatus motion_profile_bulk_write(MotionProfileThreadPool& thread_pool, const MotionProfileBulkJob* jobs, size_t job_count, float time_step, const char* path) {
+	if (!(time_step > 0) || !std::isfinite(time_step)) return MotionProfileBulkStatus::INVALID_JOB;
+	// plan every move, then lay the samples out in job order
+	std::vector<MotionProfileBulkPlan> move_plans(job_count);
+	thread_pool.parallel_for(job_count, MOTION_PROFILE_BULK_PLAN_CHUNK, [&](size_t move_begin, size_t move_end) {
+		for (size_t move_index = move_begin; move_index < move_end; move_index++) {
+			const MotionProfileBulkJob& job = jobs[move_index];
+			if (job.kind == MotionProfileBulkKind::TRAPEZOIDAL) move_plans[move_index] = motion_profile_bulk_plan(TrapezoidalMotionProfile(job.distance, job.velocity_max, job.acceleration_max));
+			else                                                move_plans[move_index] = motion_profile_bulk_plan(SigmoidMotionProfile(job.distance, job.velocity_max, job.acceleration_max, job.jerk));
+		}
+	});
+	std::vector<uint64_t> sample_offsets(job_count);
+	uint64_t              sample_count = 0;
+	for (size_t move_index = 0; move_index < job_count; move_index++) {
+		float time_end = move_plans[move_index].time_end;
+		if (!(time_end >= 0) || !std::isfinite(time_end)) return MotionProfileBulkStatus::INVALID_JOB;
+		sample_offsets[move_index] = sample_count;
+		sample_count              += (uint64_t) std::ceil((double) time_end / time_step) + 1;
+	}
+	// sections
+	MotionProfileBulkHeader header = {};
+	std::memcpy(header.magic, motion_profile_bulk_magic, sizeof(header.magic));
+	header.version           = MOTION_PROFILE_BULK_VERSION;
+	header.header_bytes      = sizeof(MotionProfileBulkHeader);
+	header.move_count        = job_count;
+	header.sample_count      = sample_count;
+	header.time_step         = time_step;
+	header.column_count      = (uint32_t) MotionProfileBulkColumn::COUNT;
+	header.move_index_offset = motion_profile_bulk_align(sizeof(MotionProfileBulkHeader));
+	uint64_t section_offset  = motion_profile_bulk_align(header.move_index_offset + job_count * sizeof(MotionProfileBulkMove));
+	for (int column_index = 0; column_index < (int) MotionProfileBulkColumn::COUNT; column_index++) {
+		header.column_offsets[column_index] = section_offset;
+		section_offset                      = motion_profile_bulk_align(section_offset + sample_count * sizeof(float));
+	}
+	header.file_bytes = section_offset;
+	size_t                  file_bytes      = (size_t) header.file_bytes;
+	MotionProfileBulkStatus status          = MotionProfileBulkStatus::OK;
+	char*                   mapping_address = (char*) motion_profile_bulk_map(path, true, file_bytes, status);
+	if (mapping_address == nullptr) return status;
+	MotionProfileBulkMove* moves = (MotionProfileBulkMove*) (mapping_address + header.move_index_offset);
+	for (size_t move_index = 0; move_index < job_count; move_index++) {
+		moves[move_index] = {jobs[move_index], move_plans[move_index].time_end, 0, sample_offsets[move_index], (move_index + 1 < job_count ? sample_offsets[move_index + 1] : sample_count) - sample_offsets[move_index]};
+	}
+	float* columns[(int) MotionProfileBulkColumn::COUNT];
+	for (int column_index = 0; column_index < (int) MotionProfileBulkColumn::COUNT; column_index++) columns[column_index] = (float*) (mapping_address + header.column_offsets[column_index]);
+	// sample chunks cut across moves, so one long move is spread over every thread just like many short ones
+	thread_pool.parallel_for((size_t) sample_count, MOTION_PROFILE_BULK_SAMPLE_CHUNK, [&](size_t sample_begin, size_t sample_end) {
+		size_t move_index = (size_t) (std::upper_bound(sample_offsets.begin(), sample_offsets.end(), (uint64_t) sample_begin) - sample_offsets.begin()) - 1;
+		for (size_t sample_index = sample_begin; sample_index < sample_end; move_index++) {
+			const MotionProfileBulkMove& move        = moves[move_index];
+			const MotionProfileBulkPlan& move_plan   = move_plans[move_index];
+			size_t                       move_end    = std::min((size_t) (move.sample_offset + move.sample_count), sample_end);
+			float*                       times       = columns[(int) MotionProfileBulkColumn::TIME] + sample_index;
+			for (size_t move_sample = sample_index; move_sample < move_end; move_sample++) {
+				uint64_t tick = move_sample - move.sample_offset;
+				times[move_sample - sample_index] = (tick + 1 == move.sample_count ? move_plan.time_end : std::min((float) (tick * (double) time_step), move_plan.time_end));
+			}
+			MotionProfileSamples samples = {
+				columns[(int) MotionProfileBulkColumn::DISTANCE]     + sample_index,
+				columns[(int) MotionProfileBulkColumn::VELOCITY]     + sample_index,
+				columns[(int) MotionProfileBulkColumn::ACCELERATION] + sample_index,
+				columns[(int) MotionProfileBulkColumn::JERK]         + sample_index
+			};
+			motion_profile_segment_batch(move_plan.segments, move_plan.segment_count, times, move_end - sample_index, samples);
+			sample_index = move_end;
+		}
+	});
+	// the header goes in last, a file cut short by a crash does not pass as complete
+	std::memcpy(mapping_address, &header, sizeof(header));
+	motion_profile_bulk_unmap(mapping_address, file_bytes);
+	return MotionProfileBulkStatus::OK;
+}
+
+MotionProfileBulkFile::~MotionProfileBulkFile() {
+	this->close();
+}
+
+MotionProfileBulkStatus MotionProfileBulkFile::open(const char* path) {
+	this->close();
+	size_t                  file_bytes      = 0;
+	MotionProfileBulkStatus status          = MotionProfileBulkStatus::OK;
+	const char*             mapping_address = (const char*) motion_profile_bulk_map(path, false, file_bytes, status);
+	if (mapping_address == nullptr) return status;
+	// every section has to lie inside the file before anything is read from it
+	const MotionProfileBulkHeader* header     = (const MotionProfileBulkHeader*) mapping_address;
+	bool                           file_valid = file_bytes >= sizeof(MotionProfileBulkHeader)
+		&& std::memcmp(header->magic, motion_profile_bulk_magic, sizeof(header->magic)) == 0
+		&& header->version == MOTION_PROFILE_BULK_VERSION
+		&& header->header_bytes == sizeof(MotionProfileBulkHeader)
+		&& header->column_count == (uint32_t) MotionProfileBulkColumn::COUNT
+		&& header->file_bytes <= file_bytes
+		&& header->move_index_offset % alignof(MotionProfileBulkMove) == 0
+		&& header->move_count <= (file_bytes - std::min((uint64_t) file_bytes, header->move_index_offset)) / sizeof(MotionProfileBulkMove);
+	for (int column_index = 0; file_valid && column_index < (int) MotionProfileBulkColumn::COUNT; column_index++) {
+		uint64_t column_offset = header->column_offsets[column_index];
+		file_valid = column_offset % alignof(float) == 0 && column_offset <= file_bytes && header->sample_count <= (file_bytes - column_offset) / sizeof(float);
+	}
+	const MotionProfileBulkMove* moves = (const MotionProfileBulkMove*) (mapping_address + (file_valid ? header->move_index_offset : 0));
+	for (uint64_t move_index = 0; file_valid && move_index < header->move_count; move_index++) {
+		file_valid = moves[move_index].sample_offset <= header->sample_count && moves[move_index].sample_count <= header->sample_count - moves[move_index].sample_offset;
+	}
+	if (!file_valid) {
+		motion_profile_bulk_unmap((void*) mapping_address, file_bytes);
+		return MotionProfileBulkStatus::INVALID_FILE;
+	}
+	this->mapping_address = (void*) mapping_address;
+	this->mapping_bytes   = file_bytes;
+	this->header          = header;
+	this->moves           = moves;
+	for (int column_index = 0; column_index < (int) MotionProfileBulkColumn::COUNT; column_index++) this->columns[column_index] = (const float*) (mapping_address + header->column_offsets[column_index]);
+	return MotionProfileBulkStatus::OK;
+}
+
+void MotionProfileBulkFile::close() {
+	if (this->mapping_address != nullptr) motion_profile_bulk_unmap(this->mapping_address, this->mapping_bytes);
+	this->mapping_address = nullptr;
+	this->mapping_bytes   = 0;
+	this->header          = nullptr;
+	this->moves           = nullptr;
+	for (const float*& column : this->columns) column = nullptr;
+}
\ No newline at end of file
@@ -0,0 +1,93 @@
+#pragma once
+#include <cstdint>
+#include <cstddef>
+#include "../motion_profile_parallel/motion_profile_parallel.h"
+
+#define MOTION_PROFILE_BULK_VERSION       1
+#define MOTION_PROFILE_BULK_ALIGNMENT     64    // sections (and so every column) begin on a cache line
+#define MOTION_PROFILE_BULK_PLAN_CHUNK    256   // moves planned per chunk
+#define MOTION_PROFILE_BULK_SAMPLE_CHUNK  16384 // samples per chunk, chunks may span several moves
+
+// columnar file of sampled moves, in the byte order of the machine that wrote it:
+//   header | move index | time column | distance column | velocity column | acceleration column | jerk column
+// every column holds the samples of all moves back to back, a move owns the range [sample_offset, sample_offset +
+// sample_count) of each. samples are taken every time step from 0, the last one lands exactly on the end of the move.
+enum class MotionProfileBulkColumn {
+	TIME,
+	DISTANCE,
+	VELOCITY,
+	ACCELERATION,
+	JERK,
+	COUNT
+};
+
+enum class MotionProfileBulkKind : uint32_t {
+	SIGMOID,
+	TRAPEZOIDAL
+};
+
+enum class MotionProfileBulkStatus {
+	OK,
+	INVALID_JOB,    // non-positive time step, or a move without a finite end
+	FILE_FAILED,    // the file could not be created, sized or opened
+	MAPPING_FAILED, // the file could not be mapped
+	INVALID_FILE    // not a bulk file of this version, or truncated
+};
+
+// one move to generate (the jerk is ignored by trapezoidal moves)
+struct MotionProfileBulkJob {
+	MotionProfileBulkKind kind;
+	float                 distance;
+	float                 velocity_max;
+	float                 acceleration_max;
+	float                 jerk;
+};
+
+struct MotionProfileBulkHeader {
+	char     magic[8];                                           // "MPBULK" padded with zeros
+	uint32_t version;
+	uint32_t header_bytes;                                       // sizeof the header, checked on open
+	uint64_t move_count;
+	uint64_t sample_count;                                       // samples of all moves (per column)
+	uint64_t move_index_offset;                                  // byte offset of the move index
+	uint64_t column_offsets[(int) MotionProfileBulkColumn::COUNT]; // byte offset of every column
+	uint64_t file_bytes;
+	float    time_step;
+	uint32_t column_count;
+};
+
+struct MotionProfileBulkMove {
+	MotionProfileBulkJob job;
+	float                time_end;
+	uint32_t             reserved;
+	uint64_t             sample_offset;
+	uint64_t             sample_count;
+};
+
+// plans and samples every job on the pool and writes them to path (replacing it). the file is mapped and sized up
+// front, the workers write the samples straight into it in chunks of samples taken in turn by whoever is free
+MotionProfileBulkStatus motion_profile_bulk_write(MotionProfileThreadPool& thread_pool, const MotionProfileBulkJob* jobs, size_t job_count, float time_step, const char* path);
+
+// read-only, zero-copy view of a bulk file. the pointers handed out point into the mapping and stay valid until the
+// file is closed or destroyed
+class MotionProfileBulkFile {
+public:
+	MotionProfileBulkFile                                    () = default;
+	~MotionProfileBulkFile                                   ();
+	MotionProfileBulkFile                                    (const MotionProfileBulkFile&) = delete;
+	MotionProfileBulkFile&         operator=                 (const MotionProfileBulkFile&) = delete;
+	MotionProfileBulkStatus        open                      (const char* path);
+	void                           close                     ();
+	bool                           is_open                   () const { return this->header != nullptr; }
+	const MotionProfileBulkHeader& get_header                () const { return *this->header; }
+	size_t                         get_move_count            () const { return (size_t) this->header->move_count; }
+	const MotionProfileBulkMove&   get_move                  (size_t move_index) const { return this->moves[move_index]; }
+	const float*                   get_column                (MotionProfileBulkColumn column) const { return this->columns[(int) column]; } // all moves
+	const float*                   get_move_column           (size_t move_index, MotionProfileBulkColumn column) const { return this->columns[(int) column] + this->moves[move_index].sample_offset; }
+private:
+	void*                          mapping_address = nullptr;
+	size_t                         mapping_bytes   = 0;
+	const MotionProfileBulkHeader* header          = nullptr;
+	const MotionProfileBulkMove*   moves           = nullptr;
+	const float*                   columns[(int) MotionProfileBulkColumn::COUNT] = {};
+};
\ No newline at end of file
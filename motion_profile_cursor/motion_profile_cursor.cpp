@@ -0,0 +1,41 @@
+#include "motion_profile_cursor.h"
+
+MotionProfileCursor::MotionProfileCursor(const MotionProfileSegment* segments, int segment_count, float time_end, float time_step) noexcept {
+	this->segments      = segments;
+	this->segment_count = segment_count;
+	this->segment_index = 0;
+	this->time_end      = time_end;
+	this->time_step     = (time_step > 0.0f ? time_step : time_end); // a non-positive step only yields the two end points
+	this->tick_index    = 0;
+	this->tick_last     = false;
+	this->tick_done     = false;
+	this->anchor(0.0f);
+}
+
+void MotionProfileCursor::anchor(float progress_time) noexcept {
+	if (progress_time >= this->time_end) {
+		progress_time   = this->time_end;
+		this->tick_last = true;
+	}
+	// segments are only ever crossed forward
+	while (this->segment_index + 1 < this->segment_count && this->segments[this->segment_index + 1].time_begin <= progress_time) this->segment_index++;
+	const MotionProfileSegment& segment = this->segments[this->segment_index];
+	float time_section = progress_time - segment.time_begin;
+	float time_step    = this->time_step;
+	this->time_segment_next   = (this->segment_index + 1 < this->segment_count ? this->segments[this->segment_index + 1].time_begin : this->time_end);
+	this->tick_anchor         = MOTION_PROFILE_CURSOR_ANCHOR_TICKS;
+	this->sample.time         = progress_time;
+	this->sample.distance     = motion_profile_segment_distance(segment, time_section);
+	this->sample.velocity     = motion_profile_segment_velocity(segment, time_section);
+	this->sample.acceleration = motion_profile_segment_acceleration(segment, time_section);
+	this->sample.jerk         = motion_profile_segment_jerk(segment);
+	// forward differences of the segment polynomials at the current time for the fixed step
+	float cubic_third  = segment.cubic_degree_third;
+	float cubic_second = segment.cubic_degree_second;
+	this->distance_difference[0]  = cubic_third * (3 * time_section * time_section * time_step + 3 * time_section * time_step * time_step + time_step * time_step * time_step) + cubic_second * (2 * time_section * time_step + time_step * time_step) + segment.cubic_degree_first * time_step;
+	this->distance_difference[1]  = cubic_third * (6 * time_section * time_step * time_step + 6 * time_step * time_step * time_step) + 2 * cubic_second * time_step * time_step;
+	this->distance_difference[2]  = 6 * cubic_third * time_step * time_step * time_step;
+	this->velocity_difference[0]  = 3 * cubic_third * (2 * time_section * time_step + time_step * time_step) + 2 * cubic_second * time_step;
+	this->velocity_difference[1]  = 6 * cubic_third * time_step * time_step;
+	this->acceleration_difference = 6 * cubic_third * time_step;
+}
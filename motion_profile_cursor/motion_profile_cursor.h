@@ -0,0 +1,74 @@
+#pragma once
+#include "../motion_profile_segment/motion_profile_segment.h"
+
+// re-evaluate the closed form every this many ticks so forward-difference rounding stays bounded inside long segments
+#define MOTION_PROFILE_CURSOR_ANCHOR_TICKS 64
+
+struct MotionProfileSample {
+	float time;
+	float distance;
+	float velocity;
+	float acceleration;
+	float jerk;
+};
+
+// fixed-step stream over a segment table: each tick is a handful of additions (exact forward differences of the
+// segment cubic), the closed form is only evaluated again when a segment boundary is crossed or every anchor period.
+// the last sample lands exactly on time_end. the segment table must outlive the cursor.
+class MotionProfileCursor {
+public:
+	class Iterator {
+	public:
+		Iterator                   (MotionProfileCursor* cursor) noexcept : cursor(cursor) {}
+		const MotionProfileSample& operator*  () const noexcept                        { return this->cursor->get_sample(); }
+		Iterator&                  operator++ () noexcept                              { this->cursor->advance(); return *this; }
+		bool                       operator!= (const Iterator& other) const noexcept   { return !this->is_end() || !other.is_end(); }
+	private:
+		MotionProfileCursor* cursor;
+		bool is_end() const noexcept { return this->cursor == nullptr || this->cursor->is_done(); }
+	};
+
+	MotionProfileCursor                   (const MotionProfileSegment* segments, int segment_count, float time_end, float time_step) noexcept;
+	const MotionProfileSample& get_sample () const noexcept { return this->sample; }
+	bool                       is_done    () const noexcept { return this->tick_done; }
+	Iterator                   begin      () noexcept       { return Iterator(this); }
+	Iterator                   end        () noexcept       { return Iterator(nullptr); }
+	inline void                advance    () noexcept;
+private:
+	const MotionProfileSegment* segments;
+	int                         segment_count;
+	int                         segment_index;
+	float                       time_end;
+	float                       time_step;
+	float                       time_segment_next; // time the following segment begins (re-anchor when crossed)
+	long long                   tick_index;        // ticks since the start (time is tick_index * time_step, never accumulated)
+	int                         tick_anchor;       // ticks left until the next periodic re-anchor
+	bool                        tick_last;         // the current sample is the one at time_end
+	bool                        tick_done;
+	MotionProfileSample         sample;
+	float                       distance_difference[3];  // first, second and third forward difference of distance
+	float                       velocity_difference[2];  // first and second forward difference of velocity
+	float                       acceleration_difference; // first forward difference of acceleration
+
+	void anchor(float progress_time) noexcept;
+};
+
+inline void MotionProfileCursor::advance() noexcept {
+	if (this->tick_last) {
+		this->tick_done = true;
+		return;
+	}
+	this->tick_index++;
+	float progress_time = (float) this->tick_index * this->time_step;
+	if (progress_time >= this->time_end || progress_time >= this->time_segment_next || --this->tick_anchor <= 0) {
+		this->anchor(progress_time);
+		return;
+	}
+	this->sample.time             = progress_time;
+	this->sample.distance        += this->distance_difference[0];
+	this->distance_difference[0] += this->distance_difference[1];
+	this->distance_difference[1] += this->distance_difference[2];
+	this->sample.velocity        += this->velocity_difference[0];
+	this->velocity_difference[0] += this->velocity_difference[1];
+	this->sample.acceleration    += this->acceleration_difference;
+}
@@ -0,0 +1,114 @@
+#include <cmath>
+#include <algorithm>
+#include "motion_profile_fixed.h"
+
+// fraction bits that keep a magnitude below 2^30 (a bit of headroom for rounding on top of the sign bit)
+int motion_profile_fixed_fraction_bits(double magnitude) noexcept {
+	if (!(magnitude > 0)) return 30;
+	int magnitude_exponent = 0;
+	std::frexp(magnitude, &magnitude_exponent); // magnitude < 2^magnitude_exponent
+	return std::min(std::max(30 - magnitude_exponent, -30), 30);
+}
+
+MotionProfileFixed motion_profile_fixed_export(const MotionProfileSegment* segments, int segment_count, float time_end, MotionProfileFixedErrorBounds* error_bounds) noexcept {
+	// segments beyond the table are cut off, the profile then ends where the first of them begins
+	if (segment_count > MOTION_PROFILE_FIXED_SEGMENT_COUNT_MAX) {
+		time_end      = segments[MOTION_PROFILE_FIXED_SEGMENT_COUNT_MAX].time_begin;
+		segment_count = MOTION_PROFILE_FIXED_SEGMENT_COUNT_MAX;
+	}
+	// the tables handed to the target
+	MotionProfileFixedSegment fixed_segments[MOTION_PROFILE_FIXED_SEGMENT_COUNT_MAX] = {};
+	int                       fixed_segment_count                                    = 0;
+	MotionProfileFixedFormat  format                                                 = {};
+	format.time_fraction_bits = motion_profile_fixed_fraction_bits(time_end);
+	int     time_fraction_bits = format.time_fraction_bits;
+	int32_t fixed_time_end     = motion_profile_fixed_encode(time_end, time_fraction_bits);
+	// polynomials in the normalized time of each segment (in double until the formats are known)
+	double segment_durations[MOTION_PROFILE_FIXED_SEGMENT_COUNT_MAX]      = {};
+	double segment_time_begins[MOTION_PROFILE_FIXED_SEGMENT_COUNT_MAX]    = {};
+	double distance_cubics[MOTION_PROFILE_FIXED_SEGMENT_COUNT_MAX][4]      = {};
+	double velocity_quadratics[MOTION_PROFILE_FIXED_SEGMENT_COUNT_MAX][3]  = {};
+	double acceleration_linears[MOTION_PROFILE_FIXED_SEGMENT_COUNT_MAX][2] = {};
+	double distance_range                                                  = 0;
+	double velocity_range                                                  = 0;
+	double acceleration_range                                              = 0;
+	for (int segment_index = 0; segment_index < segment_count; segment_index++) {
+		const MotionProfileSegment& segment          = segments[segment_index];
+		double                      time_begin       = segment.time_begin;
+		double                      time_segment_end = (segment_index + 1 < segment_count ? segments[segment_index + 1].time_begin : time_end);
+		// a segment shorter than a tick is never landed in (a profile keeps at least its first one)
+		bool segment_empty = motion_profile_fixed_encode(time_segment_end, time_fraction_bits) <= motion_profile_fixed_encode(time_begin, time_fraction_bits);
+		if (segment_empty && !(fixed_segment_count == 0 && segment_index + 1 == segment_count)) continue;
+		int    fixed_index = fixed_segment_count++;
+		double duration    = std::max(time_segment_end - time_begin, 0.0);
+		double cubic[4]    = {segment.cubic_degree_zero, segment.cubic_degree_first, segment.cubic_degree_second, segment.cubic_degree_third};
+		segment_durations[fixed_index]       = duration;
+		segment_time_begins[fixed_index]     = time_begin;
+		distance_cubics[fixed_index][0]      = cubic[0];
+		distance_cubics[fixed_index][1]      = cubic[1] * duration;
+		distance_cubics[fixed_index][2]      = cubic[2] * duration * duration;
+		distance_cubics[fixed_index][3]      = cubic[3] * duration * duration * duration;
+		velocity_quadratics[fixed_index][0]  = cubic[1];
+		velocity_quadratics[fixed_index][1]  = 2 * cubic[2] * duration;
+		velocity_quadratics[fixed_index][2]  = 3 * cubic[3] * duration * duration;
+		acceleration_linears[fixed_index][0] = 2 * cubic[2];
+		acceleration_linears[fixed_index][1] = 6 * cubic[3] * duration;
+		// every horner partial sum is bounded by the sum of the magnitudes
+		distance_range     = std::max(distance_range,     std::fabs(distance_cubics[fixed_index][0]) + std::fabs(distance_cubics[fixed_index][1]) + std::fabs(distance_cubics[fixed_index][2]) + std::fabs(distance_cubics[fixed_index][3]));
+		velocity_range     = std::max(velocity_range,     std::fabs(velocity_quadratics[fixed_index][0]) + std::fabs(velocity_quadratics[fixed_index][1]) + std::fabs(velocity_quadratics[fixed_index][2]));
+		acceleration_range = std::max(acceleration_range, std::fabs(acceleration_linears[fixed_index][0]) + std::fabs(acceleration_linears[fixed_index][1]));
+	}
+	format.distance_fraction_bits     = motion_profile_fixed_fraction_bits(distance_range);
+	format.velocity_fraction_bits     = motion_profile_fixed_fraction_bits(velocity_range);
+	format.acceleration_fraction_bits = motion_profile_fixed_fraction_bits(acceleration_range);
+	double distance_unit      = std::ldexp(1.0, (-1) * format.distance_fraction_bits);
+	double velocity_unit      = std::ldexp(1.0, (-1) * format.velocity_fraction_bits);
+	double acceleration_unit  = std::ldexp(1.0, (-1) * format.acceleration_fraction_bits);
+	double distance_error     = 0;
+	double velocity_error     = 0;
+	double acceleration_error = 0;
+	for (int fixed_index = 0; fixed_index < fixed_segment_count; fixed_index++) {
+		MotionProfileFixedSegment& fixed_segment = fixed_segments[fixed_index];
+		double                     duration      = segment_durations[fixed_index];
+		fixed_segment.time_begin = motion_profile_fixed_encode(segment_time_begins[fixed_index], time_fraction_bits);
+		// reciprocal of the duration scaled into [2^30, 2^31) by the shift
+		double time_section_inverse = (duration > 0 ? std::ldexp(1.0, 31 - time_fraction_bits) / duration : std::ldexp(1.0, 31));
+		int    inverse_exponent     = 0;
+		std::frexp(time_section_inverse, &inverse_exponent);
+		fixed_segment.time_section_shift   = std::min(std::max(31 - inverse_exponent, 0), 62);
+		double inverse_scaled              = std::ldexp(time_section_inverse, fixed_segment.time_section_shift);
+		fixed_segment.time_section_inverse = (int32_t) std::min(std::llround(inverse_scaled), (long long) INT32_MAX);
+		for (int degree = 0; degree < 4; degree++) fixed_segment.distance_cubic[degree]      = motion_profile_fixed_encode(distance_cubics[fixed_index][degree],      format.distance_fraction_bits);
+		for (int degree = 0; degree < 3; degree++) fixed_segment.velocity_quadratic[degree]  = motion_profile_fixed_encode(velocity_quadratics[fixed_index][degree],  format.velocity_fraction_bits);
+		for (int degree = 0; degree < 2; degree++) fixed_segment.acceleration_linear[degree] = motion_profile_fixed_encode(acceleration_linears[fixed_index][degree], format.acceleration_fraction_bits);
+		// error of u: the reciprocal rounding (relative), u rounding and saturation below 1 (2^-31 each) and the segment
+		// begin rounded to half a tick. it reaches the outputs through their slope in u, and each coefficient and each
+		// horner step adds half a unit in the last place
+		double inverse_error      = std::fabs(fixed_segment.time_section_inverse - inverse_scaled) / inverse_scaled;
+		double time_section_error = inverse_error + std::ldexp(1.5, -31) + (duration > 0 ? std::ldexp(0.5, (-1) * time_fraction_bits) / duration : 0.0);
+		double distance_slope     = std::fabs(distance_cubics[fixed_index][1]) + 2 * std::fabs(distance_cubics[fixed_index][2]) + 3 * std::fabs(distance_cubics[fixed_index][3]);
+		double velocity_slope     = std::fabs(velocity_quadratics[fixed_index][1]) + 2 * std::fabs(velocity_quadratics[fixed_index][2]);
+		double acceleration_slope = std::fabs(acceleration_linears[fixed_index][1]);
+		distance_error     = std::max(distance_error,     distance_slope * time_section_error + 3.5 * distance_unit);
+		velocity_error     = std::max(velocity_error,     velocity_slope * time_section_error + 2.5 * velocity_unit);
+		acceleration_error = std::max(acceleration_error, acceleration_slope * time_section_error + 1.5 * acceleration_unit);
+	}
+	// rounded up so the float bounds still hold
+	if (error_bounds != nullptr) {
+		*error_bounds = {
+			std::nextafter((float) distance_error,     INFINITY),
+			std::nextafter((float) velocity_error,     INFINITY),
+			std::nextafter((float) acceleration_error, INFINITY)
+		};
+	}
+	return MotionProfileFixed(fixed_segments, fixed_segment_count, fixed_time_end, format);
+}
+
+int32_t motion_profile_fixed_encode(double value, int fraction_bits) noexcept {
+	double scaled = std::ldexp(value, fraction_bits);
+	return (int32_t) std::llround(std::min(std::max(scaled, (double) INT32_MIN), (double) INT32_MAX));
+}
+
+double motion_profile_fixed_decode(int32_t value, int fraction_bits) noexcept {
+	return std::ldexp((double) value, (-1) * fraction_bits);
+}
\ No newline at end of file
@@ -0,0 +1,20 @@
+#pragma once
+#include <cstdint>
+#include "../motion_profile_segment/motion_profile_segment.h"
+#include "motion_profile_fixed_eval.h"
+
+// worst deviation of the fixed point results from the exported segments evaluated exactly at the same tick
+struct MotionProfileFixedErrorBounds {
+	float distance;
+	float velocity;
+	float acceleration;
+};
+
+// exports a segment table on the host (in floating point): picks the q formats from the value ranges and rewrites every
+// segment for integer evaluation. segments shorter than a tick are dropped. the error bounds of the export are written
+// when asked for
+MotionProfileFixed motion_profile_fixed_export(const MotionProfileSegment* segments, int segment_count, float time_end, MotionProfileFixedErrorBounds* error_bounds = nullptr) noexcept;
+
+// conversions for the host side (and for tests)
+int32_t motion_profile_fixed_encode (double value, int fraction_bits) noexcept;
+double  motion_profile_fixed_decode (int32_t value, int fraction_bits) noexcept;
\ No newline at end of file
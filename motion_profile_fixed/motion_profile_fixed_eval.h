@@ -0,0 +1,99 @@
+#pragma once
+#include <cstdint>
+
+#define MOTION_PROFILE_FIXED_SEGMENT_COUNT_MAX 16 // segments an exported profile holds (a replan needs 11)
+
+// q formats of an exported profile: every value is an int32_t holding value * 2^fraction_bits
+struct MotionProfileFixedFormat {
+	int time_fraction_bits;
+	int distance_fraction_bits;
+	int velocity_fraction_bits;
+	int acceleration_fraction_bits;
+};
+
+// one segment in its own normalized time u = (time - time_begin) / duration in q31, so every polynomial term is in the
+// units (and q format) of its output and evaluation is horner with 32x32->64 multiplies and shifts only
+struct MotionProfileFixedSegment {
+	int32_t time_begin;               // q time
+	int32_t time_section_inverse;     // 2^(31 - time bits + inverse shift) / duration, in [2^30, 2^31)
+	int32_t time_section_shift;       // inverse shift
+	int32_t distance_cubic[4];        // distance in u (degree zero first)
+	int32_t velocity_quadratic[3];    // velocity in u (degree zero first)
+	int32_t acceleration_linear[2];   // acceleration in u (degree zero first)
+};
+
+// integer evaluation of a profile for controllers without a floating point unit: the queries only use integer
+// multiplies, adds and shifts and take the time in q time ticks. the tables are exported on the host (see
+// motion_profile_fixed_export) and handed to the target as plain integers, which builds the evaluator from them here.
+// tables longer than the maximum keep their beginning, an empty one rests at zero.
+class MotionProfileFixed {
+public:
+	MotionProfileFixed                                        () noexcept = default;
+	MotionProfileFixed                                        (const MotionProfileFixedSegment* segments, int segment_count, int32_t time_end, MotionProfileFixedFormat format) noexcept; // target side
+	inline int32_t                   get_time_distance        (int32_t progress_time) const noexcept;
+	inline int32_t                   get_time_velocity        (int32_t progress_time) const noexcept;
+	inline int32_t                   get_time_acceleration    (int32_t progress_time) const noexcept;
+	int32_t                          get_time_end             () const noexcept { return this->time_end; }
+	int                              get_segment_count        () const noexcept { return this->segment_count; }
+	const MotionProfileFixedSegment* get_segments             () const noexcept { return this->segments; }
+	MotionProfileFixedFormat         get_format               () const noexcept { return this->format; }
+private:
+	MotionProfileFixedSegment segments[MOTION_PROFILE_FIXED_SEGMENT_COUNT_MAX] = {};
+	int                       segment_count                                    = 1;
+	int32_t                   time_end                                         = 0;
+	MotionProfileFixedFormat  format                                           = {};
+
+	inline int     fixed_segment_index (int32_t progress_time) const noexcept;
+	inline int32_t fixed_time_section  (const MotionProfileFixedSegment& segment, int32_t progress_time) const noexcept; // u in q31
+};
+
+// value * u with u in q31, rounded to nearest
+inline int32_t motion_profile_fixed_multiply(int32_t value, int32_t time_section) noexcept {
+	return (int32_t) (((int64_t) value * time_section + (int64_t(1) << 30)) >> 31);
+}
+
+inline MotionProfileFixed::MotionProfileFixed(const MotionProfileFixedSegment* segments, int segment_count, int32_t time_end, MotionProfileFixedFormat format) noexcept {
+	if (segment_count > MOTION_PROFILE_FIXED_SEGMENT_COUNT_MAX) segment_count = MOTION_PROFILE_FIXED_SEGMENT_COUNT_MAX;
+	for (int segment_index = 0; segment_index < segment_count; segment_index++) this->segments[segment_index] = segments[segment_index];
+	this->segment_count = (segment_count > 0 ? segment_count : 1);
+	this->time_end      = time_end;
+	this->format        = format;
+}
+
+inline int32_t MotionProfileFixed::get_time_distance(int32_t progress_time) const noexcept {
+	const MotionProfileFixedSegment& segment      = this->segments[this->fixed_segment_index(progress_time)];
+	int32_t                          time_section = this->fixed_time_section(segment, progress_time);
+	int32_t                          distance     = segment.distance_cubic[3];
+	distance = motion_profile_fixed_multiply(distance, time_section) + segment.distance_cubic[2];
+	distance = motion_profile_fixed_multiply(distance, time_section) + segment.distance_cubic[1];
+	return motion_profile_fixed_multiply(distance, time_section) + segment.distance_cubic[0];
+}
+
+inline int32_t MotionProfileFixed::get_time_velocity(int32_t progress_time) const noexcept {
+	const MotionProfileFixedSegment& segment      = this->segments[this->fixed_segment_index(progress_time)];
+	int32_t                          time_section = this->fixed_time_section(segment, progress_time);
+	int32_t                          velocity     = segment.velocity_quadratic[2];
+	velocity = motion_profile_fixed_multiply(velocity, time_section) + segment.velocity_quadratic[1];
+	return motion_profile_fixed_multiply(velocity, time_section) + segment.velocity_quadratic[0];
+}
+
+inline int32_t MotionProfileFixed::get_time_acceleration(int32_t progress_time) const noexcept {
+	const MotionProfileFixedSegment& segment      = this->segments[this->fixed_segment_index(progress_time)];
+	int32_t                          time_section = this->fixed_time_section(segment, progress_time);
+	return motion_profile_fixed_multiply(segment.acceleration_linear[1], time_section) + segment.acceleration_linear[0];
+}
+
+inline int MotionProfileFixed::fixed_segment_index(int32_t progress_time) const noexcept {
+	int segment_index = this->segment_count - 1;
+	while (segment_index > 0 && this->segments[segment_index].time_begin > progress_time) segment_index--;
+	return segment_index;
+}
+
+inline int32_t MotionProfileFixed::fixed_time_section(const MotionProfileFixedSegment& segment, int32_t progress_time) const noexcept {
+	// the profile rests at both ends, u saturates inside [0, 1)
+	if (progress_time > this->time_end) progress_time = this->time_end;
+	int32_t time_section_ticks = progress_time - segment.time_begin;
+	if (time_section_ticks <= 0) return 0;
+	int64_t time_section = ((int64_t) time_section_ticks * segment.time_section_inverse + ((int64_t(1) << segment.time_section_shift) >> 1)) >> segment.time_section_shift;
+	return (int32_t) (time_section < INT32_MAX ? time_section : INT32_MAX);
+}
\ No newline at end of file
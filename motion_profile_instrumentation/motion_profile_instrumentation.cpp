@@ -0,0 +1,153 @@
+#include <mutex>
+#include <atomic>
+#include <cmath>
+#include <algorithm>
+#include "motion_profile_instrumentation.h"
+
+// counters of one thread. only the owning thread writes them (plain load and store, no read-modify-write), snapshots
+// read them concurrently, hence the relaxed atomics
+struct MotionProfileInstrumentBlock {
+	std::atomic<unsigned long long> api_call_counts[(int) MotionProfileApi::COUNT];
+	std::atomic<unsigned long long> api_time_totals[(int) MotionProfileApi::COUNT];
+	std::atomic<unsigned long long> api_latency_histograms[(int) MotionProfileApi::COUNT][MOTION_PROFILE_INSTRUMENTATION_BUCKETS];
+	std::atomic<unsigned long long> solver_branch_counts[(int) MotionProfileSolverBranch::COUNT];
+	std::atomic<unsigned long long> residual_count;
+	std::atomic<unsigned long long> residual_histogram[MOTION_PROFILE_INSTRUMENTATION_BUCKETS];
+	std::atomic<double>             residual_max;
+	int                             call_depth = 0; // instrumented calls the thread is inside of
+	MotionProfileInstrumentBlock*   block_next = nullptr;
+
+	MotionProfileInstrumentBlock  ();
+	~MotionProfileInstrumentBlock ();
+	void clear                    () noexcept;
+	void merge                    (MotionProfileInstrumentationSnapshot& snapshot) const noexcept;
+};
+
+// blocks of running threads in an intrusive list (registering never allocates), and what exited threads counted
+std::mutex                           motion_profile_instrument_mutex;
+MotionProfileInstrumentBlock*        motion_profile_instrument_blocks  = nullptr;
+MotionProfileInstrumentationSnapshot motion_profile_instrument_retired = {};
+
+thread_local MotionProfileInstrumentBlock motion_profile_instrument_block;
+
+void motion_profile_instrument_add(std::atomic<unsigned long long>& counter, unsigned long long value) noexcept {
+	counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+}
+
+int motion_profile_instrument_bucket(double value) noexcept {
+	if (!(value >= 1)) return 0;
+	return std::min(std::ilogb(value), MOTION_PROFILE_INSTRUMENTATION_BUCKETS - 1);
+}
+
+MotionProfileInstrumentBlock::MotionProfileInstrumentBlock() {
+	this->clear();
+	std::lock_guard<std::mutex> instrument_lock(motion_profile_instrument_mutex);
+	this->block_next                 = motion_profile_instrument_blocks;
+	motion_profile_instrument_blocks = this;
+}
+
+MotionProfileInstrumentBlock::~MotionProfileInstrumentBlock() {
+	std::lock_guard<std::mutex> instrument_lock(motion_profile_instrument_mutex);
+	this->merge(motion_profile_instrument_retired);
+	MotionProfileInstrumentBlock** block_link = &motion_profile_instrument_blocks;
+	while (*block_link != this) block_link = &(*block_link)->block_next;
+	*block_link = this->block_next;
+}
+
+void MotionProfileInstrumentBlock::clear() noexcept {
+	for (int api_index = 0; api_index < (int) MotionProfileApi::COUNT; api_index++) {
+		this->api_call_counts[api_index].store(0, std::memory_order_relaxed);
+		this->api_time_totals[api_index].store(0, std::memory_order_relaxed);
+		for (int bucket_index = 0; bucket_index < MOTION_PROFILE_INSTRUMENTATION_BUCKETS; bucket_index++) this->api_latency_histograms[api_index][bucket_index].store(0, std::memory_order_relaxed);
+	}
+	for (int branch_index = 0; branch_index < (int) MotionProfileSolverBranch::COUNT; branch_index++) this->solver_branch_counts[branch_index].store(0, std::memory_order_relaxed);
+	this->residual_count.store(0, std::memory_order_relaxed);
+	for (int bucket_index = 0; bucket_index < MOTION_PROFILE_INSTRUMENTATION_BUCKETS; bucket_index++) this->residual_histogram[bucket_index].store(0, std::memory_order_relaxed);
+	this->residual_max.store(0, std::memory_order_relaxed);
+}
+
+void MotionProfileInstrumentBlock::merge(MotionProfileInstrumentationSnapshot& snapshot) const noexcept {
+	for (int api_index = 0; api_index < (int) MotionProfileApi::COUNT; api_index++) {
+		snapshot.api_stats[api_index].call_count    += this->api_call_counts[api_index].load(std::memory_order_relaxed);
+		snapshot.api_stats[api_index].time_total_ns += this->api_time_totals[api_index].load(std::memory_order_relaxed);
+		for (int bucket_index = 0; bucket_index < MOTION_PROFILE_INSTRUMENTATION_BUCKETS; bucket_index++) snapshot.api_stats[api_index].latency_histogram[bucket_index] += this->api_latency_histograms[api_index][bucket_index].load(std::memory_order_relaxed);
+	}
+	for (int branch_index = 0; branch_index < (int) MotionProfileSolverBranch::COUNT; branch_index++) snapshot.solver_branch_counts[branch_index] += this->solver_branch_counts[branch_index].load(std::memory_order_relaxed);
+	snapshot.residual_count += this->residual_count.load(std::memory_order_relaxed);
+	for (int bucket_index = 0; bucket_index < MOTION_PROFILE_INSTRUMENTATION_BUCKETS; bucket_index++) snapshot.residual_histogram[bucket_index] += this->residual_histogram[bucket_index].load(std::memory_order_relaxed);
+	snapshot.residual_max = std::max(snapshot.residual_max, this->residual_max.load(std::memory_order_relaxed));
+}
+
+MotionProfileInstrumentationSnapshot motion_profile_instrumentation_snapshot() noexcept {
+	std::lock_guard<std::mutex> instrument_lock(motion_profile_instrument_mutex);
+	MotionProfileInstrumentationSnapshot snapshot = motion_profile_instrument_retired;
+	for (const MotionProfileInstrumentBlock* block = motion_profile_instrument_blocks; block != nullptr; block = block->block_next) block->merge(snapshot);
+	return snapshot;
+}
+
+void motion_profile_instrumentation_reset() noexcept {
+	// counts a thread makes while it is cleared may survive or get lost, either is fine for telemetry
+	std::lock_guard<std::mutex> instrument_lock(motion_profile_instrument_mutex);
+	motion_profile_instrument_retired = {};
+	for (MotionProfileInstrumentBlock* block = motion_profile_instrument_blocks; block != nullptr; block = block->block_next) block->clear();
+}
+
+const char* motion_profile_api_name(MotionProfileApi api) noexcept {
+	switch (api) {
+		case MotionProfileApi::SIGMOID_CONSTRUCT:                     return "sigmoid_construct";
+		case MotionProfileApi::SIGMOID_GET_TIME_DISTANCE:             return "sigmoid_get_time_distance";
+		case MotionProfileApi::SIGMOID_GET_TIME_VELOCITY:             return "sigmoid_get_time_velocity";
+		case MotionProfileApi::SIGMOID_GET_TIME_ACCELERATION:         return "sigmoid_get_time_acceleration";
+		case MotionProfileApi::SIGMOID_GET_TIME_JERK:                 return "sigmoid_get_time_jerk";
+		case MotionProfileApi::SIGMOID_GET_DISTANCE_TIME:             return "sigmoid_get_distance_time";
+		case MotionProfileApi::SIGMOID_GET_DISTANCE_VELOCITY:         return "sigmoid_get_distance_velocity";
+		case MotionProfileApi::SIGMOID_GET_DISTANCE_ACCELERATION:     return "sigmoid_get_distance_acceleration";
+		case MotionProfileApi::SIGMOID_GET_DISTANCE_JERK:             return "sigmoid_get_distance_jerk";
+		case MotionProfileApi::TRAPEZOIDAL_CONSTRUCT:                 return "trapezoidal_construct";
+		case MotionProfileApi::TRAPEZOIDAL_GET_DISTANCE:              return "trapezoidal_get_distance";
+		case MotionProfileApi::TRAPEZOIDAL_GET_VELOCITY:              return "trapezoidal_get_velocity";
+		case MotionProfileApi::TRAPEZOIDAL_GET_TIME_ACCELERATION:     return "trapezoidal_get_time_acceleration";
+		case MotionProfileApi::TRAPEZOIDAL_GET_DISTANCE_TIME:         return "trapezoidal_get_distance_time";
+		case MotionProfileApi::TRAPEZOIDAL_GET_DISTANCE_VELOCITY:     return "trapezoidal_get_distance_velocity";
+		case MotionProfileApi::TRAPEZOIDAL_GET_DISTANCE_ACCELERATION: return "trapezoidal_get_distance_acceleration";
+		default:                                                      return "unknown";
+	}
+}
+
+const char* motion_profile_solver_branch_name(MotionProfileSolverBranch solver_branch) noexcept {
+	switch (solver_branch) {
+		case MotionProfileSolverBranch::CUBIC_QUADRATIC:   return "cubic_quadratic";
+		case MotionProfileSolverBranch::CUBIC_CUBE_ROOT:   return "cubic_cube_root";
+		case MotionProfileSolverBranch::CUBIC_GENERAL:     return "cubic_general";
+		case MotionProfileSolverBranch::INVERSE_AT_BEGIN:  return "inverse_at_begin";
+		case MotionProfileSolverBranch::INVERSE_NEWTON:    return "inverse_newton";
+		case MotionProfileSolverBranch::INVERSE_BISECT:    return "inverse_bisect";
+		case MotionProfileSolverBranch::INVERSE_EXHAUSTED: return "inverse_exhausted";
+		default:                                           return "unknown";
+	}
+}
+
+bool motion_profile_instrument_enter() noexcept {
+	return motion_profile_instrument_block.call_depth++ == 0;
+}
+
+void motion_profile_instrument_exit(MotionProfileApi api, bool call_outermost, long long time_ns) noexcept {
+	MotionProfileInstrumentBlock& block = motion_profile_instrument_block;
+	block.call_depth--;
+	if (!call_outermost) return;
+	motion_profile_instrument_add(block.api_call_counts[(int) api], 1);
+	motion_profile_instrument_add(block.api_time_totals[(int) api], (unsigned long long) std::max(time_ns, 0LL));
+	motion_profile_instrument_add(block.api_latency_histograms[(int) api][motion_profile_instrument_bucket((double) time_ns)], 1);
+}
+
+void motion_profile_instrument_branch(MotionProfileSolverBranch solver_branch) noexcept {
+	motion_profile_instrument_add(motion_profile_instrument_block.solver_branch_counts[(int) solver_branch], 1);
+}
+
+void motion_profile_instrument_residual(double residual) noexcept {
+	MotionProfileInstrumentBlock& block = motion_profile_instrument_block;
+	residual = std::fabs(residual);
+	motion_profile_instrument_add(block.residual_count, 1);
+	motion_profile_instrument_add(block.residual_histogram[motion_profile_instrument_bucket(std::ldexp(residual, MOTION_PROFILE_INSTRUMENTATION_RESIDUAL_SHIFT))], 1);
+	if (residual > block.residual_max.load(std::memory_order_relaxed)) block.residual_max.store(residual, std::memory_order_relaxed);
+}
\ No newline at end of file
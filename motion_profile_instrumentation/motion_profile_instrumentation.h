@@ -0,0 +1,97 @@
+#pragma once
+#include <chrono>
+#include <type_traits>
+
+// optional hot path telemetry, compiled in with MOTION_PROFILE_INSTRUMENTATION (cmake option of the same name, off by
+// default). every thread counts into its own block and the blocks are only merged when a snapshot is taken, so calls
+// never contend. without the flag the hooks are empty and the snapshot api reports zeros.
+#define MOTION_PROFILE_INSTRUMENTATION_BUCKETS        32  // histogram buckets (powers of two)
+#define MOTION_PROFILE_INSTRUMENTATION_RESIDUAL_SHIFT 40  // residual bucket i holds residuals below 2^(i - shift)
+
+enum class MotionProfileApi {
+	SIGMOID_CONSTRUCT,
+	SIGMOID_GET_TIME_DISTANCE,
+	SIGMOID_GET_TIME_VELOCITY,
+	SIGMOID_GET_TIME_ACCELERATION,
+	SIGMOID_GET_TIME_JERK,
+	SIGMOID_GET_DISTANCE_TIME,
+	SIGMOID_GET_DISTANCE_VELOCITY,
+	SIGMOID_GET_DISTANCE_ACCELERATION,
+	SIGMOID_GET_DISTANCE_JERK,
+	TRAPEZOIDAL_CONSTRUCT,
+	TRAPEZOIDAL_GET_DISTANCE,
+	TRAPEZOIDAL_GET_VELOCITY,
+	TRAPEZOIDAL_GET_TIME_ACCELERATION,
+	TRAPEZOIDAL_GET_DISTANCE_TIME,
+	TRAPEZOIDAL_GET_DISTANCE_VELOCITY,
+	TRAPEZOIDAL_GET_DISTANCE_ACCELERATION,
+	COUNT
+};
+
+enum class MotionProfileSolverBranch {
+	CUBIC_QUADRATIC,   // sigmoid_cubic_solve without a cubic term
+	CUBIC_CUBE_ROOT,   // sigmoid_cubic_solve with only the cubic and constant terms
+	CUBIC_GENERAL,     // sigmoid_cubic_solve through the general formula
+	INVERSE_AT_BEGIN,  // segment inverse of a distance at or before the segment begin (no iteration)
+	INVERSE_NEWTON,    // newton steps of the segment inverse
+	INVERSE_BISECT,    // steps that left the bracket and bisected instead
+	INVERSE_EXHAUSTED, // inverses that ran out of iterations before converging
+	COUNT
+};
+
+struct MotionProfileInstrumentationSnapshot {
+	struct ApiStats {
+		unsigned long long call_count;
+		unsigned long long time_total_ns;
+		unsigned long long latency_histogram[MOTION_PROFILE_INSTRUMENTATION_BUCKETS]; // bucket i holds calls below 2^(i + 1) ns
+	};
+
+	ApiStats           api_stats[(int) MotionProfileApi::COUNT];
+	unsigned long long solver_branch_counts[(int) MotionProfileSolverBranch::COUNT];
+	unsigned long long residual_count;    // get_distance_time calls inside the profile with their residual checked
+	unsigned long long residual_histogram[MOTION_PROFILE_INSTRUMENTATION_BUCKETS];
+	double             residual_max;      // worst |distance(time(d)) - d|
+};
+
+MotionProfileInstrumentationSnapshot motion_profile_instrumentation_snapshot () noexcept; // merges every thread
+void                                 motion_profile_instrumentation_reset    () noexcept;
+const char*                          motion_profile_api_name                 (MotionProfileApi api) noexcept;
+const char*                          motion_profile_solver_branch_name       (MotionProfileSolverBranch solver_branch) noexcept;
+
+// recording hooks behind the macros below
+bool motion_profile_instrument_enter    () noexcept; // true for the outermost instrumented call of the thread
+void motion_profile_instrument_exit     (MotionProfileApi api, bool call_outermost, long long time_ns) noexcept;
+void motion_profile_instrument_branch   (MotionProfileSolverBranch solver_branch) noexcept;
+void motion_profile_instrument_residual (double residual) noexcept;
+
+// times an api call from its construction to the end of the scope. calls made inside another instrumented call (the
+// distance queries go through get_distance_time) are not counted again, constant evaluation is never recorded
+class MotionProfileInstrumentScope {
+public:
+	constexpr MotionProfileInstrumentScope(MotionProfileApi api) noexcept : api(api) {
+		if (std::is_constant_evaluated()) return;
+		this->call_outermost = motion_profile_instrument_enter();
+		if (this->call_outermost) this->time_begin = std::chrono::steady_clock::now();
+	}
+	constexpr ~MotionProfileInstrumentScope() noexcept {
+		if (std::is_constant_evaluated()) return;
+		long long time_ns = (this->call_outermost ? (long long) std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - this->time_begin).count() : 0);
+		motion_profile_instrument_exit(this->api, this->call_outermost, time_ns);
+	}
+	MotionProfileInstrumentScope(const MotionProfileInstrumentScope&) = delete;
+	MotionProfileInstrumentScope& operator=(const MotionProfileInstrumentScope&) = delete;
+private:
+	MotionProfileApi                      api;
+	bool                                  call_outermost = false;
+	std::chrono::steady_clock::time_point time_begin     = {};
+};
+
+#ifdef MOTION_PROFILE_INSTRUMENTATION
+#define MOTION_PROFILE_INSTRUMENT_CALL(api)                 MotionProfileInstrumentScope motion_profile_instrument_scope(api)
+#define MOTION_PROFILE_INSTRUMENT_BRANCH(solver_branch)     do { if (!std::is_constant_evaluated()) motion_profile_instrument_branch(solver_branch); } while (0)
+#define MOTION_PROFILE_INSTRUMENT_RESIDUAL(residual)        do { if (!std::is_constant_evaluated()) motion_profile_instrument_residual(residual); } while (0)
+#else
+#define MOTION_PROFILE_INSTRUMENT_CALL(api)                 ((void) 0)
+#define MOTION_PROFILE_INSTRUMENT_BRANCH(solver_branch)     ((void) 0)
+#define MOTION_PROFILE_INSTRUMENT_RESIDUAL(residual)        ((void) 0)
+#endif
\ No newline at end of file
@@ -0,0 +1,65 @@
+#pragma once
+#include <concepts>
+#include <cstddef>
+#include <type_traits>
+#include "../motion_profile_segment/motion_profile_segment.h"
+#include "../motion_profile_cursor/motion_profile_cursor.h"
+
+// static interface shared by the profile shapes (crtp, no virtual calls). a shape derives from
+// MotionProfileInterface<Shape, Scalar> and exposes its segment table and end time, the batch, inverse batch and cursor
+// paths are written once here on top of them and inlined for either shape. a shape with a faster inverse than the
+// generic one declares its own profile_distance_time_batch, which the interface then calls instead of the default
+template <typename Profile, typename Scalar>
+class MotionProfileInterface {
+public:
+	using ProfileScalar = Scalar;
+
+	void                get_time_batch              (const float* progress_times, size_t time_count, MotionProfileSamples samples) const noexcept;
+	void                get_distance_time_batch     (const float* progress_distances, size_t distance_count, float* progress_times) const noexcept; // distances sorted ascending
+	MotionProfileCursor get_cursor                  (float time_step) const noexcept;
+	// hook behind get_distance_time_batch (the iterative inverse over the segment table unless the shape hides it)
+	void                profile_distance_time_batch (const float* progress_distances, size_t distance_count, float* progress_times) const noexcept;
+protected:
+	constexpr MotionProfileInterface() noexcept = default;
+private:
+	constexpr const Profile& profile() const noexcept { return static_cast<const Profile&>(*this); }
+};
+
+// what generic sampling code may rely on, for a shape of any scalar type
+template <typename Profile>
+concept MotionProfileShape = requires(const Profile& motion_profile, typename Profile::ProfileScalar value) {
+	{ motion_profile.get_time_distance(value) }         -> std::same_as<typename Profile::ProfileScalar>;
+	{ motion_profile.get_time_velocity(value) }         -> std::same_as<typename Profile::ProfileScalar>;
+	{ motion_profile.get_time_acceleration(value) }     -> std::same_as<typename Profile::ProfileScalar>;
+	{ motion_profile.get_time_jerk(value) }             -> std::same_as<typename Profile::ProfileScalar>;
+	{ motion_profile.get_distance_time(value) }         -> std::same_as<typename Profile::ProfileScalar>;
+	{ motion_profile.get_distance_velocity(value) }     -> std::same_as<typename Profile::ProfileScalar>;
+	{ motion_profile.get_distance_acceleration(value) } -> std::same_as<typename Profile::ProfileScalar>;
+	{ motion_profile.get_time_end() }                   -> std::same_as<typename Profile::ProfileScalar>;
+	{ motion_profile.get_segments() }                   -> std::same_as<const BasicMotionProfileSegment<typename Profile::ProfileScalar>*>;
+	{ motion_profile.get_segment_count() }              -> std::same_as<int>;
+	motion_profile.get_phase(value);
+};
+
+template <typename Profile, typename Scalar>
+void MotionProfileInterface<Profile, Scalar>::get_time_batch(const float* progress_times, size_t time_count, MotionProfileSamples samples) const noexcept {
+	static_assert(std::is_same<Scalar, float>::value, "batch evaluation is float only");
+	motion_profile_segment_batch(this->profile().get_segments(), this->profile().get_segment_count(), progress_times, time_count, samples);
+}
+
+template <typename Profile, typename Scalar>
+void MotionProfileInterface<Profile, Scalar>::get_distance_time_batch(const float* progress_distances, size_t distance_count, float* progress_times) const noexcept {
+	static_assert(std::is_same<Scalar, float>::value, "batch evaluation is float only");
+	this->profile().profile_distance_time_batch(progress_distances, distance_count, progress_times);
+}
+
+template <typename Profile, typename Scalar>
+void MotionProfileInterface<Profile, Scalar>::profile_distance_time_batch(const float* progress_distances, size_t distance_count, float* progress_times) const noexcept {
+	motion_profile_segment_inverse_batch(this->profile().get_segments(), this->profile().get_segment_count(), this->profile().get_time_end(), progress_distances, distance_count, progress_times);
+}
+
+template <typename Profile, typename Scalar>
+MotionProfileCursor MotionProfileInterface<Profile, Scalar>::get_cursor(float time_step) const noexcept {
+	static_assert(std::is_same<Scalar, float>::value, "the cursor is float only");
+	return MotionProfileCursor(this->profile().get_segments(), this->profile().get_segment_count(), this->profile().get_time_end(), time_step);
+}
\ No newline at end of file
@@ -0,0 +1,72 @@
+#include <algorithm>
+#include "motion_profile_parallel.h"
+
+MotionProfileThreadPool::MotionProfileThreadPool(int thread_count) {
+	if (thread_count <= 0) thread_count = std::max((int) std::thread::hardware_concurrency(), 1);
+	for (int thread_index = 1; thread_index < thread_count; thread_index++) this->threads.emplace_back(&MotionProfileThreadPool::worker_run, this);
+}
+
+MotionProfileThreadPool::~MotionProfileThreadPool() {
+	{
+		std::lock_guard<std::mutex> job_lock(this->job_mutex);
+		this->pool_stop = true;
+	}
+	this->job_wake.notify_all();
+	for (std::thread& thread : this->threads) thread.join();
+}
+
+int MotionProfileThreadPool::get_thread_count() const {
+	return (int) this->threads.size() + 1;
+}
+
+void MotionProfileThreadPool::parallel_for(size_t item_count, size_t chunk_size, const std::function<void(size_t item_begin, size_t item_end)>& chunk_body) {
+	if (item_count == 0) return;
+	chunk_size = std::max(chunk_size, (size_t) 1);
+	// not worth waking anyone for a single chunk
+	if (this->threads.empty() || item_count <= chunk_size) {
+		chunk_body(0, item_count);
+		return;
+	}
+	std::lock_guard<std::mutex> job_submit_lock(this->job_submit_mutex);
+	{
+		std::lock_guard<std::mutex> job_lock(this->job_mutex);
+		this->job_body         = &chunk_body;
+		this->job_item_count   = item_count;
+		this->job_chunk_size   = chunk_size;
+		this->job_chunk_next.store(0, std::memory_order_relaxed);
+		this->job_workers_busy = (int) this->threads.size();
+		this->job_generation++;
+	}
+	this->job_wake.notify_all();
+	this->job_run();
+	// the body must stay alive until every worker left it
+	std::unique_lock<std::mutex> job_lock(this->job_mutex);
+	this->job_done.wait(job_lock, [this]() { return this->job_workers_busy == 0; });
+	this->job_body = nullptr;
+}
+
+void MotionProfileThreadPool::worker_run() {
+	unsigned long long job_generation_seen = 0;
+	while (true) {
+		{
+			std::unique_lock<std::mutex> job_lock(this->job_mutex);
+			this->job_wake.wait(job_lock, [&]() { return this->pool_stop || this->job_generation != job_generation_seen; });
+			if (this->pool_stop) return;
+			job_generation_seen = this->job_generation;
+		}
+		this->job_run();
+		std::lock_guard<std::mutex> job_lock(this->job_mutex);
+		if (--this->job_workers_busy == 0) this->job_done.notify_one();
+	}
+}
+
+void MotionProfileThreadPool::job_run() {
+	// chunks are handed out in order from a shared counter, whoever is free takes the next one
+	size_t chunk_count = (this->job_item_count + this->job_chunk_size - 1) / this->job_chunk_size;
+	while (true) {
+		size_t chunk_index = this->job_chunk_next.fetch_add(1, std::memory_order_relaxed);
+		if (chunk_index >= chunk_count) return;
+		size_t item_begin = chunk_index * this->job_chunk_size;
+		(*this->job_body)(item_begin, std::min(item_begin + this->job_chunk_size, this->job_item_count));
+	}
+}
\ No newline at end of file
@@ -0,0 +1,37 @@
+#pragma once
+#include <mutex>
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <cstddef>
+#include <functional>
+#include <condition_variable>
+
+// fixed set of worker threads for splitting bulk work (planning or sampling many moves) into chunks. the calling thread
+// takes chunks too, so a pool of one thread runs everything inline. one job runs at a time, further callers wait.
+class MotionProfileThreadPool {
+public:
+	MotionProfileThreadPool                   (int thread_count = 0); // threads including the caller, 0 uses every hardware thread
+	~MotionProfileThreadPool                  ();
+	MotionProfileThreadPool                   (const MotionProfileThreadPool&) = delete;
+	MotionProfileThreadPool& operator=        (const MotionProfileThreadPool&) = delete;
+	int                      get_thread_count () const;
+	// calls chunk_body(item_begin, item_end) over [0, item_count) in chunks of chunk_size items and returns once all ran
+	void                     parallel_for     (size_t item_count, size_t chunk_size, const std::function<void(size_t item_begin, size_t item_end)>& chunk_body);
+private:
+	std::vector<std::thread>                   threads;
+	std::mutex                                 job_submit_mutex; // serializes parallel_for callers
+	std::mutex                                 job_mutex;
+	std::condition_variable                    job_wake;
+	std::condition_variable                    job_done;
+	const std::function<void(size_t, size_t)>* job_body         = nullptr;
+	size_t                                     job_item_count   = 0;
+	size_t                                     job_chunk_size   = 1;
+	std::atomic<size_t>                        job_chunk_next   = 0;
+	int                                        job_workers_busy = 0; // workers still inside the current job
+	unsigned long long                         job_generation   = 0; // bumped for every job so sleeping workers notice it
+	bool                                       pool_stop        = false;
+
+	void worker_run ();
+	void job_run    ();
+};
\ No newline at end of file
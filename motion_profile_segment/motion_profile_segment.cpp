@@ -0,0 +1,163 @@
+#include <cmath>
+#include "motion_profile_segment.h"
+#include "motion_profile_segment_simd.h"
+
+void motion_profile_segment_batch_scalar(const MotionProfileSegment* segments, int segment_count, const float* progress_times, size_t time_begin, size_t time_end, MotionProfileSamples samples) noexcept;
+#ifdef MOTION_PROFILE_SEGMENT_X86
+void motion_profile_segment_batch_sse41(const MotionProfileSegment* segments, int segment_count, const float* progress_times, size_t time_count, MotionProfileSamples samples) noexcept;
+void motion_profile_segment_batch_avx2(const MotionProfileSegment* segments, int segment_count, const float* progress_times, size_t time_count, MotionProfileSamples samples) noexcept;
+#endif
+
+void motion_profile_segment_inverse_batch(const MotionProfileSegment* segments, int segment_count, float time_end, const float* progress_distances, size_t distance_count, float* progress_times) noexcept {
+	// sorted distances only ever move forward through the segments. the solves are deliberately not seeded with the
+	// previous root: that chains every solve on the one before and runs slower than independent solves
+	int segment_index = 0;
+	for (size_t distance_index = 0; distance_index < distance_count; distance_index++) {
+		float progress_distance = progress_distances[distance_index];
+		while (segment_index + 1 < segment_count && segments[segment_index + 1].cubic_degree_zero <= progress_distance) segment_index++;
+		float time_section_max         = (segment_index + 1 < segment_count ? segments[segment_index + 1].time_begin : time_end) - segments[segment_index].time_begin;
+		progress_times[distance_index] = segments[segment_index].time_begin + motion_profile_segment_solve(segments[segment_index], time_section_max, progress_distance - segments[segment_index].cubic_degree_zero, -1.0f);
+	}
+}
+
+MotionProfileBatchKernel motion_profile_batch_kernel_supported() noexcept {
+	static const MotionProfileBatchKernel batch_kernel_supported = []() {
+#if defined(MOTION_PROFILE_SEGMENT_X86) && defined(_MSC_VER)
+		int cpu_info[4];
+		__cpuid(cpu_info, 0);
+		int  cpu_leaf_max  = cpu_info[0];
+		__cpuid(cpu_info, 1);
+		bool cpu_sse41     = (cpu_info[2] & (1 << 19)) != 0;
+		bool cpu_avx_state = (cpu_info[2] & (1 << 27)) != 0 && (cpu_info[2] & (1 << 28)) != 0 && (_xgetbv(0) & 6) == 6;
+		bool cpu_avx2      = false;
+		if (cpu_leaf_max >= 7 && cpu_avx_state) {
+			__cpuidex(cpu_info, 7, 0);
+			cpu_avx2 = (cpu_info[1] & (1 << 5)) != 0;
+		}
+#elif defined(MOTION_PROFILE_SEGMENT_X86)
+		__builtin_cpu_init();
+		bool cpu_sse41 = __builtin_cpu_supports("sse4.1");
+		bool cpu_avx2  = __builtin_cpu_supports("avx2");
+#else
+		bool cpu_sse41 = false;
+		bool cpu_avx2  = false;
+#endif
+		if (cpu_avx2) return MotionProfileBatchKernel::AVX2;
+		if (cpu_sse41) return MotionProfileBatchKernel::SSE41;
+		return MotionProfileBatchKernel::SCALAR;
+	}();
+	return batch_kernel_supported;
+}
+
+void motion_profile_segment_batch(const MotionProfileSegment* segments, int segment_count, const float* progress_times, size_t time_count, MotionProfileSamples samples, MotionProfileBatchKernel batch_kernel) noexcept {
+	// never run a kernel the cpu does not support
+	if ((int) batch_kernel > (int) motion_profile_batch_kernel_supported()) batch_kernel = motion_profile_batch_kernel_supported();
+	switch (batch_kernel) {
+#ifdef MOTION_PROFILE_SEGMENT_X86
+		case MotionProfileBatchKernel::AVX2:
+			motion_profile_segment_batch_avx2(segments, segment_count, progress_times, time_count, samples);
+			return;
+		case MotionProfileBatchKernel::SSE41:
+			motion_profile_segment_batch_sse41(segments, segment_count, progress_times, time_count, samples);
+			return;
+#endif
+		default:
+			motion_profile_segment_batch_scalar(segments, segment_count, progress_times, 0, time_count, samples);
+			return;
+	}
+}
+
+void motion_profile_segment_batch_scalar(const MotionProfileSegment* segments, int segment_count, const float* progress_times, size_t time_begin, size_t time_end, MotionProfileSamples samples) noexcept {
+	for (size_t time_index = time_begin; time_index < time_end; time_index++) {
+		float                       progress_time = progress_times[time_index];
+		const MotionProfileSegment& segment       = segments[motion_profile_segment_search(segments, segment_count, progress_time)];
+		float                       time_section  = progress_time - segment.time_begin;
+		if (samples.distance     != nullptr) samples.distance[time_index]     = motion_profile_segment_distance(segment, time_section);
+		if (samples.velocity     != nullptr) samples.velocity[time_index]     = motion_profile_segment_velocity(segment, time_section);
+		if (samples.acceleration != nullptr) samples.acceleration[time_index] = motion_profile_segment_acceleration(segment, time_section);
+		if (samples.jerk         != nullptr) samples.jerk[time_index]         = motion_profile_segment_jerk(segment);
+	}
+}
+
+#ifdef MOTION_PROFILE_SEGMENT_X86
+// the vector kernels select the segment of every lane without branches: each later segment whose begin
+// time has passed overwrites the lane's coefficients through a compare mask, then one horner runs per lane
+
+MOTION_PROFILE_TARGET_SSE41 void motion_profile_segment_batch_sse41(const MotionProfileSegment* segments, int segment_count, const float* progress_times, size_t time_count, MotionProfileSamples samples) noexcept {
+	size_t time_index = 0;
+	for (; time_index + 4 <= time_count; time_index += 4) {
+		__m128 progress_time = _mm_loadu_ps(progress_times + time_index);
+		__m128 time_begin    = _mm_set1_ps(segments[0].time_begin);
+		__m128 cubic_third   = _mm_set1_ps(segments[0].cubic_degree_third);
+		__m128 cubic_second  = _mm_set1_ps(segments[0].cubic_degree_second);
+		__m128 cubic_first   = _mm_set1_ps(segments[0].cubic_degree_first);
+		__m128 cubic_zero    = _mm_set1_ps(segments[0].cubic_degree_zero);
+		for (int segment_index = 1; segment_index < segment_count; segment_index++) {
+			const MotionProfileSegment& segment = segments[segment_index];
+			__m128 segment_mask = _mm_cmpge_ps(progress_time, _mm_set1_ps(segment.time_begin));
+			time_begin   = _mm_blendv_ps(time_begin,   _mm_set1_ps(segment.time_begin),          segment_mask);
+			cubic_third  = _mm_blendv_ps(cubic_third,  _mm_set1_ps(segment.cubic_degree_third),  segment_mask);
+			cubic_second = _mm_blendv_ps(cubic_second, _mm_set1_ps(segment.cubic_degree_second), segment_mask);
+			cubic_first  = _mm_blendv_ps(cubic_first,  _mm_set1_ps(segment.cubic_degree_first),  segment_mask);
+			cubic_zero   = _mm_blendv_ps(cubic_zero,   _mm_set1_ps(segment.cubic_degree_zero),   segment_mask);
+		}
+		__m128 time_section = _mm_sub_ps(progress_time, time_begin);
+		if (samples.distance != nullptr) {
+			__m128 value_distance = _mm_add_ps(_mm_mul_ps(_mm_add_ps(_mm_mul_ps(_mm_add_ps(_mm_mul_ps(cubic_third, time_section), cubic_second), time_section), cubic_first), time_section), cubic_zero);
+			_mm_storeu_ps(samples.distance + time_index, value_distance);
+		}
+		if (samples.velocity != nullptr) {
+			__m128 value_velocity = _mm_add_ps(_mm_mul_ps(_mm_add_ps(_mm_mul_ps(_mm_mul_ps(_mm_set1_ps(3.0f), cubic_third), time_section), _mm_mul_ps(_mm_set1_ps(2.0f), cubic_second)), time_section), cubic_first);
+			_mm_storeu_ps(samples.velocity + time_index, value_velocity);
+		}
+		if (samples.acceleration != nullptr) {
+			__m128 value_acceleration = _mm_add_ps(_mm_mul_ps(_mm_mul_ps(_mm_set1_ps(6.0f), cubic_third), time_section), _mm_mul_ps(_mm_set1_ps(2.0f), cubic_second));
+			_mm_storeu_ps(samples.acceleration + time_index, value_acceleration);
+		}
+		if (samples.jerk != nullptr) {
+			_mm_storeu_ps(samples.jerk + time_index, _mm_mul_ps(_mm_set1_ps(6.0f), cubic_third));
+		}
+	}
+	motion_profile_segment_batch_scalar(segments, segment_count, progress_times, time_index, time_count, samples);
+}
+
+MOTION_PROFILE_TARGET_AVX2 void motion_profile_segment_batch_avx2(const MotionProfileSegment* segments, int segment_count, const float* progress_times, size_t time_count, MotionProfileSamples samples) noexcept {
+	size_t time_index = 0;
+	for (; time_index + 8 <= time_count; time_index += 8) {
+		__m256 progress_time = _mm256_loadu_ps(progress_times + time_index);
+		__m256 time_begin    = _mm256_set1_ps(segments[0].time_begin);
+		__m256 cubic_third   = _mm256_set1_ps(segments[0].cubic_degree_third);
+		__m256 cubic_second  = _mm256_set1_ps(segments[0].cubic_degree_second);
+		__m256 cubic_first   = _mm256_set1_ps(segments[0].cubic_degree_first);
+		__m256 cubic_zero    = _mm256_set1_ps(segments[0].cubic_degree_zero);
+		for (int segment_index = 1; segment_index < segment_count; segment_index++) {
+			const MotionProfileSegment& segment = segments[segment_index];
+			__m256 segment_mask = _mm256_cmp_ps(progress_time, _mm256_set1_ps(segment.time_begin), _CMP_GE_OQ);
+			time_begin   = _mm256_blendv_ps(time_begin,   _mm256_set1_ps(segment.time_begin),          segment_mask);
+			cubic_third  = _mm256_blendv_ps(cubic_third,  _mm256_set1_ps(segment.cubic_degree_third),  segment_mask);
+			cubic_second = _mm256_blendv_ps(cubic_second, _mm256_set1_ps(segment.cubic_degree_second), segment_mask);
+			cubic_first  = _mm256_blendv_ps(cubic_first,  _mm256_set1_ps(segment.cubic_degree_first),  segment_mask);
+			cubic_zero   = _mm256_blendv_ps(cubic_zero,   _mm256_set1_ps(segment.cubic_degree_zero),   segment_mask);
+		}
+		__m256 time_section = _mm256_sub_ps(progress_time, time_begin);
+		if (samples.distance != nullptr) {
+			__m256 value_distance = _mm256_add_ps(_mm256_mul_ps(_mm256_add_ps(_mm256_mul_ps(_mm256_add_ps(_mm256_mul_ps(cubic_third, time_section), cubic_second), time_section), cubic_first), time_section), cubic_zero);
+			_mm256_storeu_ps(samples.distance + time_index, value_distance);
+		}
+		if (samples.velocity != nullptr) {
+			__m256 value_velocity = _mm256_add_ps(_mm256_mul_ps(_mm256_add_ps(_mm256_mul_ps(_mm256_mul_ps(_mm256_set1_ps(3.0f), cubic_third), time_section), _mm256_mul_ps(_mm256_set1_ps(2.0f), cubic_second)), time_section), cubic_first);
+			_mm256_storeu_ps(samples.velocity + time_index, value_velocity);
+		}
+		if (samples.acceleration != nullptr) {
+			__m256 value_acceleration = _mm256_add_ps(_mm256_mul_ps(_mm256_mul_ps(_mm256_set1_ps(6.0f), cubic_third), time_section), _mm256_mul_ps(_mm256_set1_ps(2.0f), cubic_second));
+			_mm256_storeu_ps(samples.acceleration + time_index, value_acceleration);
+		}
+		if (samples.jerk != nullptr) {
+			_mm256_storeu_ps(samples.jerk + time_index, _mm256_mul_ps(_mm256_set1_ps(6.0f), cubic_third));
+		}
+	}
+	// leave no dirty upper halves behind for the sse code that follows (the compiler does not for the tail call)
+	_mm256_zeroupper();
+	motion_profile_segment_batch_scalar(segments, segment_count, progress_times, time_index, time_count, samples);
+}
+#endif
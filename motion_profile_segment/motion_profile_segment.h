@@ -0,0 +1,171 @@
+#pragma once
+#include <cmath>
+#include <limits>
+#include <cstddef>
+#include <type_traits>
+#include "../motion_profile_instrumentation/motion_profile_instrumentation.h"
+
+#define MOTION_PROFILE_INVERSE_ITERATIONS 24
+
+// one constant-jerk piece of a motion profile, stored as its distance cubic in time since the segment begins
+template <typename Scalar>
+struct BasicMotionProfileSegment {
+	Scalar time_begin;          // time the segment begins
+	Scalar cubic_degree_third;  // jerk / 6
+	Scalar cubic_degree_second; // acceleration / 2 (when the segment begins)
+	Scalar cubic_degree_first;  // velocity (when the segment begins)
+	Scalar cubic_degree_zero;   // distance (when the segment begins)
+};
+
+using MotionProfileSegment = BasicMotionProfileSegment<float>;
+
+// structure-of-arrays output of a batch evaluation (null columns are skipped)
+struct MotionProfileSamples {
+	float* distance;
+	float* velocity;
+	float* acceleration;
+	float* jerk;
+};
+
+enum class MotionProfileBatchKernel {
+	SCALAR,
+	SSE41,
+	AVX2
+};
+
+// square and cube root usable in constant expressions (newton from above while constant evaluated, the library otherwise)
+template <typename Scalar>
+constexpr Scalar motion_profile_sqrt(Scalar value) noexcept {
+	if (!std::is_constant_evaluated()) return std::sqrt(value);
+	if (!(value > 0)) return (value == 0 ? Scalar(0) : std::numeric_limits<Scalar>::quiet_NaN());
+	Scalar root = (value > 1 ? value : Scalar(1));
+	while (true) {
+		Scalar root_next = (root + value / root) / 2;
+		if (!(root_next < root)) return root;
+		root = root_next;
+	}
+}
+
+template <typename Scalar>
+constexpr Scalar motion_profile_cbrt(Scalar value) noexcept {
+	if (!std::is_constant_evaluated()) return std::cbrt(value);
+	if (value < 0) return (-1) * motion_profile_cbrt((-1) * value);
+	if (value == 0) return Scalar(0);
+	Scalar root = (value > 1 ? value : Scalar(1));
+	while (true) {
+		Scalar root_next = (2 * root + value / (root * root)) / 3;
+		if (!(root_next < root)) return root;
+		root = root_next;
+	}
+}
+
+template <typename Scalar>
+constexpr int motion_profile_segment_search(const BasicMotionProfileSegment<Scalar>* segments, int segment_count, Scalar progress_time) noexcept {
+	int segment_index = segment_count - 1;
+	while (segment_index > 0 && segments[segment_index].time_begin > progress_time) segment_index--;
+	return segment_index;
+}
+
+template <typename Scalar>
+constexpr int motion_profile_segment_search_distance(const BasicMotionProfileSegment<Scalar>* segments, int segment_count, Scalar progress_distance) noexcept {
+	int segment_index = segment_count - 1;
+	while (segment_index > 0 && segments[segment_index].cubic_degree_zero > progress_distance) segment_index--;
+	return segment_index;
+}
+
+// same lookups by bisection, for long segment tables
+template <typename Scalar>
+constexpr int motion_profile_segment_search_binary(const BasicMotionProfileSegment<Scalar>* segments, int segment_count, Scalar progress_time) noexcept {
+	int segment_low  = 0;
+	int segment_high = segment_count;
+	while (segment_high - segment_low > 1) {
+		int segment_middle = (segment_low + segment_high) / 2;
+		if (segments[segment_middle].time_begin <= progress_time) segment_low  = segment_middle;
+		else                                                      segment_high = segment_middle;
+	}
+	return segment_low;
+}
+
+template <typename Scalar>
+constexpr int motion_profile_segment_search_distance_binary(const BasicMotionProfileSegment<Scalar>* segments, int segment_count, Scalar progress_distance) noexcept {
+	int segment_low  = 0;
+	int segment_high = segment_count;
+	while (segment_high - segment_low > 1) {
+		int segment_middle = (segment_low + segment_high) / 2;
+		if (segments[segment_middle].cubic_degree_zero <= progress_distance) segment_low  = segment_middle;
+		else                                                                 segment_high = segment_middle;
+	}
+	return segment_low;
+}
+
+template <typename Scalar>
+constexpr Scalar motion_profile_segment_distance(const BasicMotionProfileSegment<Scalar>& segment, Scalar time_section) noexcept {
+	return ((segment.cubic_degree_third * time_section + segment.cubic_degree_second) * time_section + segment.cubic_degree_first) * time_section + segment.cubic_degree_zero;
+}
+
+template <typename Scalar>
+constexpr Scalar motion_profile_segment_velocity(const BasicMotionProfileSegment<Scalar>& segment, Scalar time_section) noexcept {
+	return (3 * segment.cubic_degree_third * time_section + 2 * segment.cubic_degree_second) * time_section + segment.cubic_degree_first;
+}
+
+template <typename Scalar>
+constexpr Scalar motion_profile_segment_acceleration(const BasicMotionProfileSegment<Scalar>& segment, Scalar time_section) noexcept {
+	return 6 * segment.cubic_degree_third * time_section + 2 * segment.cubic_degree_second;
+}
+
+template <typename Scalar>
+constexpr Scalar motion_profile_segment_jerk(const BasicMotionProfileSegment<Scalar>& segment) noexcept {
+	return 6 * segment.cubic_degree_third;
+}
+
+template <typename Scalar>
+constexpr Scalar motion_profile_segment_solve(const BasicMotionProfileSegment<Scalar>& segment, Scalar time_section_max, Scalar distance_section, Scalar time_section_guess) noexcept {
+	// safeguarded newton on the segment cubic: the root stays bracketed and any step leaving the bracket bisects instead
+	if (distance_section <= 0) {
+		MOTION_PROFILE_INSTRUMENT_BRANCH(MotionProfileSolverBranch::INVERSE_AT_BEGIN);
+		return Scalar(0);
+	}
+	Scalar time_low     = 0;
+	Scalar time_high    = (time_section_max > 0 ? time_section_max : Scalar(0));
+	Scalar time_section = time_section_guess;
+	if (!(time_section >= time_low && time_section <= time_high)) {
+		// without a guess start from the end where newton converges monotonically (the curvature agrees with the error sign)
+		time_section = (segment.cubic_degree_second > 0 || (segment.cubic_degree_second == 0 && segment.cubic_degree_third > 0)) ? time_high : time_low;
+	}
+	// stop within a few units in the last place of the scalar type
+	const Scalar time_tolerance = 8 * std::numeric_limits<Scalar>::epsilon();
+	for (int iteration = 0; iteration < MOTION_PROFILE_INVERSE_ITERATIONS; iteration++) {
+		Scalar distance_error = ((segment.cubic_degree_third * time_section + segment.cubic_degree_second) * time_section + segment.cubic_degree_first) * time_section - distance_section;
+		if (distance_error == 0) break;
+		if (distance_error > 0) time_high = time_section;
+		else                    time_low  = time_section;
+		Scalar velocity          = (3 * segment.cubic_degree_third * time_section + 2 * segment.cubic_degree_second) * time_section + segment.cubic_degree_first;
+		Scalar time_section_next = time_section - distance_error / velocity;
+		if (!(time_section_next > time_low && time_section_next < time_high)) {
+			MOTION_PROFILE_INSTRUMENT_BRANCH(MotionProfileSolverBranch::INVERSE_BISECT);
+			time_section_next = (time_low + time_high) / 2;
+		} else {
+			MOTION_PROFILE_INSTRUMENT_BRANCH(MotionProfileSolverBranch::INVERSE_NEWTON);
+		}
+		Scalar time_difference   = time_section_next - time_section;
+		bool   time_converged    = (time_difference < 0 ? (-1) * time_difference : time_difference) <= time_tolerance * time_section_next;
+		time_section             = time_section_next;
+		if (time_converged || time_high - time_low <= std::numeric_limits<Scalar>::epsilon() * time_section_max) break;
+		if (iteration + 1 == MOTION_PROFILE_INVERSE_ITERATIONS) MOTION_PROFILE_INSTRUMENT_BRANCH(MotionProfileSolverBranch::INVERSE_EXHAUSTED);
+	}
+	return time_section;
+}
+
+// inverse of a profile whose distance never decreases: distance to time, clamped to [0, time_end]
+template <typename Scalar>
+constexpr Scalar motion_profile_segment_inverse(const BasicMotionProfileSegment<Scalar>* segments, int segment_count, Scalar time_end, Scalar progress_distance) noexcept {
+	int    segment_index    = motion_profile_segment_search_distance(segments, segment_count, progress_distance);
+	Scalar time_section_max = (segment_index + 1 < segment_count ? segments[segment_index + 1].time_begin : time_end) - segments[segment_index].time_begin;
+	Scalar time_section     = motion_profile_segment_solve(segments[segment_index], time_section_max, progress_distance - segments[segment_index].cubic_degree_zero, Scalar(-1));
+	return segments[segment_index].time_begin + time_section;
+}
+
+// batch evaluation and its kernels are float only
+void                     motion_profile_segment_inverse_batch (const MotionProfileSegment* segments, int segment_count, float time_end, const float* progress_distances, size_t distance_count, float* progress_times) noexcept;
+MotionProfileBatchKernel motion_profile_batch_kernel_supported() noexcept;
+void                     motion_profile_segment_batch         (const MotionProfileSegment* segments, int segment_count, const float* progress_times, size_t time_count, MotionProfileSamples samples, MotionProfileBatchKernel batch_kernel = motion_profile_batch_kernel_supported()) noexcept;
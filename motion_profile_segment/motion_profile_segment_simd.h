@@ -0,0 +1,19 @@
+#pragma once
+
+// instruction set kernels of the batch paths (translation units only): x86 intrinsics, and the attributes that let a
+// function use an instruction set above the compiler baseline. kernels are only called after the cpu was checked
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define MOTION_PROFILE_SEGMENT_X86
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#endif
+
+#if defined(MOTION_PROFILE_SEGMENT_X86) && (defined(__GNUC__) || defined(__clang__))
+#define MOTION_PROFILE_TARGET_SSE41 __attribute__((target("sse4.1")))
+#define MOTION_PROFILE_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define MOTION_PROFILE_TARGET_SSE41
+#define MOTION_PROFILE_TARGET_AVX2
+#endif
\ No newline at end of file
@@ -1,7 +1,15 @@
 #pragma once
-#include <map>
+#include <type_traits>
+#include <algorithm>
+#include <complex>
+#include "../motion_profile_segment/motion_profile_segment.h"
+#include "../motion_profile_interface/motion_profile_interface.h"
 
-class SigmoidMotionProfile {
+// sigmoid (jerk limited) motion profile over a scalar type. construction and every query except the batch and cursor
+// paths (float only) are constexpr, so fixed moves can be baked at compile time and long moves can use double precision.
+// the batch, inverse batch and cursor paths come from the shared MotionProfileInterface
+template <typename Scalar = float>
+class BasicSigmoidMotionProfile : public MotionProfileInterface<BasicSigmoidMotionProfile<Scalar>, Scalar> {
 public:
 	enum class SigmoidParameter {
 		DISTANCE,
@@ -22,41 +30,365 @@ public:
 	};
 
 	struct SigmoidPhaseAnchors {
-		float time_phase_begin;       // time the phase begins
-		float time_phase_section;     // time the phase last
-		float time_phase_end;         // time the phase ends
-		float distance_phase_begin;   // distance the phase begins
-		float distance_phase_section; // distance the phase last
-		float distance_phase_end;     // distance the phase ends
+		Scalar time_phase_begin;       // time the phase begins
+		Scalar time_phase_section;     // time the phase last
+		Scalar time_phase_end;         // time the phase ends
+		Scalar distance_phase_begin;   // distance the phase begins
+		Scalar distance_phase_section; // distance the phase last
+		Scalar distance_phase_end;     // distance the phase ends
 	};
 
 	struct SigmoidCubicConstants {
-		float cubic_degree_third;
-		float cubic_degree_second;
-		float cubic_degree_first;
-		float cubic_degree_zero;
+		Scalar cubic_degree_third;
+		Scalar cubic_degree_second;
+		Scalar cubic_degree_first;
+		Scalar cubic_degree_zero;
 	};
 
-	SigmoidMotionProfile                          (float distance_total, float velocity_max, float acceleration_max, float jerk);
-	float               get_distance_velocity     (float progress_distance);
-	float               get_distance_acceleration (float progress_distance);
-	float               get_distance_jerk         (float progress_distance);
-	float               get_distance_time         (float progress_distance);
-	float               get_time_distance         (float progress_time);
-	float               get_time_velocity         (float progress_time);
-	float               get_time_acceleration     (float progress_time);
-	float               get_time_jerk             (float progress_time);
-	float               get_time_end              ();
-	SigmoidPhase        get_phase                 (float progress_time);
-	SigmoidPhaseAnchors get_anchors               (SigmoidPhase anchor_phase);
+	constexpr                                          BasicSigmoidMotionProfile (Scalar distance_total, Scalar velocity_max, Scalar acceleration_max, Scalar jerk) noexcept;
+	constexpr Scalar                                   get_distance_velocity     (Scalar progress_distance) const noexcept;
+	constexpr Scalar                                   get_distance_acceleration (Scalar progress_distance) const noexcept;
+	constexpr Scalar                                   get_distance_jerk         (Scalar progress_distance) const noexcept;
+	constexpr Scalar                                   get_distance_time         (Scalar progress_distance) const noexcept;
+	constexpr Scalar                                   get_time_distance         (Scalar progress_time) const noexcept;
+	constexpr Scalar                                   get_time_velocity         (Scalar progress_time) const noexcept;
+	constexpr Scalar                                   get_time_acceleration     (Scalar progress_time) const noexcept;
+	constexpr Scalar                                   get_time_jerk             (Scalar progress_time) const noexcept;
+	constexpr Scalar                                   get_time_end              () const noexcept;
+	constexpr SigmoidPhase                             get_phase                 (Scalar progress_time) const noexcept;
+	constexpr SigmoidPhaseAnchors                      get_anchors               (SigmoidPhase anchor_phase) const noexcept;
+	constexpr const BasicMotionProfileSegment<Scalar>* get_segments              () const noexcept; // the 7 phase polynomials, indexed by SigmoidPhase
+	constexpr int                                      get_segment_count         () const noexcept { return 7; }
 private:
-	float distance_total;
-	float velocity_max;
-	float velocity_max_actual;
-	float acceleration_max;
-	float acceleration_max_actual;
-	float jerk;
-	std::map<SigmoidPhase, SigmoidPhaseAnchors> phase_anchors;
-
-	float sigmoid_value(SigmoidParameter sigmoid_parameter, float progress_time);
-};
\ No newline at end of file
+	Scalar                            distance_total          = 0;
+	Scalar                            velocity_max            = 0;
+	Scalar                            velocity_max_actual     = 0;
+	Scalar                            acceleration_max        = 0;
+	Scalar                            acceleration_max_actual = 0;
+	Scalar                            jerk                    = 0;
+	SigmoidPhaseAnchors               phase_anchors[7]        = {}; // indexed by SigmoidPhase
+	BasicMotionProfileSegment<Scalar> phase_segments[7]       = {}; // distance polynomial of each phase, in time since the phase begins
+
+	constexpr int    sigmoid_phase_index (Scalar progress_time) const noexcept;
+	constexpr Scalar sigmoid_value       (SigmoidParameter sigmoid_parameter, Scalar progress_time) const noexcept;
+};
+
+using SigmoidMotionProfile = BasicSigmoidMotionProfile<float>;
+
+#define SIGMOID_BOUNDARY_SHAPE_ITERATIONS 24 // bisection steps for the reduced acceleration of a boundary move that never cruises
+
+// durations of a rest to rest move in closed form: the jerk ramps, the constant acceleration between them (retain) and
+// the constant velocity (drift). every other phase mirrors one of them, the move lasts 4 ramps, 2 retains and the drift
+template <typename Scalar>
+struct SigmoidPhaseDurations {
+	Scalar time_accelerate;
+	Scalar time_retain;
+	Scalar time_drift;
+};
+
+template <typename Scalar>
+constexpr SigmoidPhaseDurations<Scalar> sigmoid_phase_durations        (Scalar distance_total, Scalar velocity_max, Scalar acceleration_max, Scalar jerk) noexcept;
+template <typename Scalar>
+constexpr void                          sigmoid_phase_anchors_time     (Scalar distance_total, Scalar velocity_max, Scalar acceleration_max, Scalar jerk, typename BasicSigmoidMotionProfile<Scalar>::SigmoidPhaseAnchors (&phase_anchors)[7]) noexcept;
+template <typename Scalar>
+constexpr void                          sigmoid_phase_anchors_boundary (Scalar distance_total, Scalar velocity_begin, Scalar velocity_end, Scalar velocity_max, Scalar acceleration_max, Scalar jerk, typename BasicSigmoidMotionProfile<Scalar>::SigmoidPhaseAnchors (&phase_anchors)[7]) noexcept;
+template <typename Scalar>
+constexpr void                          sigmoid_phase_integrate        (Scalar jerk, Scalar velocity_begin, typename BasicSigmoidMotionProfile<Scalar>::SigmoidPhaseAnchors (&phase_anchors)[7], BasicMotionProfileSegment<Scalar> (&phase_segments)[7]) noexcept;
+
+template <typename Scalar>
+constexpr BasicSigmoidMotionProfile<Scalar>::BasicSigmoidMotionProfile(Scalar distance_total, Scalar velocity_max, Scalar acceleration_max, Scalar jerk) noexcept {
+	MOTION_PROFILE_INSTRUMENT_CALL(MotionProfileApi::SIGMOID_CONSTRUCT);
+	// initialize parameters
+	this->distance_total   = distance_total;
+	this->velocity_max     = velocity_max;
+	this->acceleration_max = acceleration_max;
+	this->jerk             = jerk;
+	// calculate phase time
+	sigmoid_phase_anchors_time(distance_total, velocity_max, acceleration_max, jerk, this->phase_anchors);
+	this->acceleration_max_actual = this->jerk * this->phase_anchors[(int) SigmoidPhase::ACCELERATE_BEGIN].time_phase_end;
+	// calculate phase polynomials (also yields the phase distance)
+	sigmoid_phase_integrate(this->jerk, Scalar(0), this->phase_anchors, this->phase_segments);
+	this->velocity_max_actual = this->phase_segments[(int) SigmoidPhase::DRIFT].cubic_degree_first;
+}
+
+template <typename Scalar>
+constexpr Scalar BasicSigmoidMotionProfile<Scalar>::get_distance_velocity(Scalar progress_distance) const noexcept {
+	MOTION_PROFILE_INSTRUMENT_CALL(MotionProfileApi::SIGMOID_GET_DISTANCE_VELOCITY);
+	Scalar progress_time = this->get_distance_time(progress_distance);
+	return this->sigmoid_value(SigmoidParameter::VELOCITY, progress_time);
+}
+
+template <typename Scalar>
+constexpr Scalar BasicSigmoidMotionProfile<Scalar>::get_distance_acceleration(Scalar progress_distance) const noexcept {
+	MOTION_PROFILE_INSTRUMENT_CALL(MotionProfileApi::SIGMOID_GET_DISTANCE_ACCELERATION);
+	Scalar progress_time = this->get_distance_time(progress_distance);
+	return this->sigmoid_value(SigmoidParameter::ACCELERATION, progress_time);
+}
+
+template <typename Scalar>
+constexpr Scalar BasicSigmoidMotionProfile<Scalar>::get_distance_jerk(Scalar progress_distance) const noexcept {
+	MOTION_PROFILE_INSTRUMENT_CALL(MotionProfileApi::SIGMOID_GET_DISTANCE_JERK);
+	Scalar progress_time = this->get_distance_time(progress_distance);
+	return this->sigmoid_value(SigmoidParameter::JERK, progress_time);
+}
+
+template <typename Scalar>
+constexpr Scalar BasicSigmoidMotionProfile<Scalar>::get_time_distance(Scalar progress_time) const noexcept {
+	MOTION_PROFILE_INSTRUMENT_CALL(MotionProfileApi::SIGMOID_GET_TIME_DISTANCE);
+	return this->sigmoid_value(SigmoidParameter::DISTANCE, progress_time);
+}
+
+template <typename Scalar>
+constexpr Scalar BasicSigmoidMotionProfile<Scalar>::get_time_velocity(Scalar progress_time) const noexcept {
+	MOTION_PROFILE_INSTRUMENT_CALL(MotionProfileApi::SIGMOID_GET_TIME_VELOCITY);
+	return this->sigmoid_value(SigmoidParameter::VELOCITY, progress_time);
+}
+
+template <typename Scalar>
+constexpr Scalar BasicSigmoidMotionProfile<Scalar>::get_time_acceleration(Scalar progress_time) const noexcept {
+	MOTION_PROFILE_INSTRUMENT_CALL(MotionProfileApi::SIGMOID_GET_TIME_ACCELERATION);
+	return this->sigmoid_value(SigmoidParameter::ACCELERATION, progress_time);
+}
+
+template <typename Scalar>
+constexpr Scalar BasicSigmoidMotionProfile<Scalar>::get_time_jerk(Scalar progress_time) const noexcept {
+	MOTION_PROFILE_INSTRUMENT_CALL(MotionProfileApi::SIGMOID_GET_TIME_JERK);
+	return this->sigmoid_value(SigmoidParameter::JERK, progress_time);
+}
+
+template <typename Scalar>
+constexpr auto BasicSigmoidMotionProfile<Scalar>::get_phase(Scalar progress_time) const noexcept -> SigmoidPhase {
+	return (SigmoidPhase) this->sigmoid_phase_index(progress_time);
+}
+
+template <typename Scalar>
+constexpr auto BasicSigmoidMotionProfile<Scalar>::get_anchors(SigmoidPhase anchor_phase) const noexcept -> SigmoidPhaseAnchors {
+	// a phase outside the enumeration reads the nearest one instead of past the table
+	return this->phase_anchors[std::min(std::max((int) anchor_phase, 0), 6)];
+}
+
+template <typename Scalar>
+constexpr const BasicMotionProfileSegment<Scalar>* BasicSigmoidMotionProfile<Scalar>::get_segments() const noexcept {
+	return this->phase_segments;
+}
+
+template <typename Scalar>
+constexpr Scalar BasicSigmoidMotionProfile<Scalar>::get_distance_time(Scalar progress_distance) const noexcept {
+	MOTION_PROFILE_INSTRUMENT_CALL(MotionProfileApi::SIGMOID_GET_DISTANCE_TIME);
+	Scalar progress_time = motion_profile_segment_inverse(this->phase_segments, 7, this->get_time_end(), progress_distance);
+#ifdef MOTION_PROFILE_INSTRUMENTATION
+	// round trip residual, only defined inside the motion (outside it the time clamps)
+	if (!std::is_constant_evaluated() && progress_distance >= 0 && progress_distance <= this->distance_total) {
+		MOTION_PROFILE_INSTRUMENT_RESIDUAL((double) this->sigmoid_value(SigmoidParameter::DISTANCE, progress_time) - (double) progress_distance);
+	}
+#endif
+	return progress_time;
+}
+
+template <typename Scalar>
+constexpr Scalar BasicSigmoidMotionProfile<Scalar>::get_time_end() const noexcept {
+	return this->phase_anchors[(int) SigmoidPhase::DECELERATE_END].time_phase_end;
+}
+
+template <typename Scalar>
+constexpr int BasicSigmoidMotionProfile<Scalar>::sigmoid_phase_index(Scalar progress_time) const noexcept {
+	return motion_profile_segment_search(this->phase_segments, 7, progress_time);
+}
+
+template <typename Scalar>
+constexpr Scalar BasicSigmoidMotionProfile<Scalar>::sigmoid_value(SigmoidParameter sigmoid_parameter, Scalar progress_time) const noexcept {
+	// find the corresponding phase by progress time
+	const BasicMotionProfileSegment<Scalar>& phase_segment         = this->phase_segments[this->sigmoid_phase_index(progress_time)];
+	Scalar                                   time_progress_section = progress_time - phase_segment.time_begin;
+	// return phase values
+	switch (sigmoid_parameter) {
+		case SigmoidParameter::DISTANCE:     return motion_profile_segment_distance(phase_segment, time_progress_section);
+		case SigmoidParameter::VELOCITY:     return motion_profile_segment_velocity(phase_segment, time_progress_section);
+		case SigmoidParameter::ACCELERATION: return motion_profile_segment_acceleration(phase_segment, time_progress_section);
+		case SigmoidParameter::JERK:         return motion_profile_segment_jerk(phase_segment);
+		default:                             return progress_time;
+	}
+}
+
+template <typename Scalar>
+constexpr SigmoidPhaseDurations<Scalar> sigmoid_phase_durations(Scalar distance_total, Scalar velocity_max, Scalar acceleration_max, Scalar jerk) noexcept {
+	SigmoidPhaseDurations<Scalar> time_accelerate_anchors = {};
+	// calculate maximum time in acceleration and velocity limits
+	Scalar time_accelerate_max = acceleration_max / jerk;
+	Scalar time_velocity_max   = velocity_max / acceleration_max;
+	time_accelerate_anchors    = {std::min(time_accelerate_max, time_velocity_max), 0, 0};
+	Scalar time_accelerate     = time_accelerate_anchors.time_accelerate;
+	// calculate maximum retain time in velocity limit
+	Scalar velocity_accelerate_full     = jerk * (time_accelerate * time_accelerate);
+	Scalar velocity_retain              = velocity_max - velocity_accelerate_full;
+	Scalar time_retain_max              = std::max(velocity_retain / (jerk * time_accelerate), Scalar(0)); // rounds below zero when both limits meet
+	time_accelerate_anchors.time_retain = time_retain_max;
+	// calculate best shape for exact distance
+	Scalar velocity_phase[3] = {};
+	velocity_phase[0] = (Scalar(1) / 2) * jerk * (time_accelerate * time_accelerate);
+	velocity_phase[1] = (jerk * time_accelerate) * time_accelerate_anchors.time_retain;
+	velocity_phase[2] = (jerk * time_accelerate) * time_accelerate - (Scalar(1) / 2) * jerk * (time_accelerate * time_accelerate);
+	Scalar distance_phase[3] = {};
+	distance_phase[0] = (Scalar(1) / 6) * jerk * (time_accelerate * time_accelerate * time_accelerate);
+	distance_phase[1] = (Scalar(1) / 2) * (jerk * time_accelerate) * (time_accelerate_anchors.time_retain * time_accelerate_anchors.time_retain) + velocity_phase[0] * time_accelerate_anchors.time_retain;
+	distance_phase[2] = (Scalar(-1) / 6) * jerk * (time_accelerate * time_accelerate * time_accelerate) + (Scalar(1) / 2) * (jerk * time_accelerate) * (time_accelerate * time_accelerate) + (velocity_phase[0] + velocity_phase[1]) * time_accelerate;
+	if (distance_total / 2 > distance_phase[0] + distance_phase[1] + distance_phase[2]) {
+		// have more than enough distance, yay! (calculate new drift)
+		Scalar distance_accelerate         = distance_phase[0] + distance_phase[1] + distance_phase[2];
+		Scalar velocity_accelerate         = velocity_phase[0] + velocity_phase[1] + velocity_phase[2];
+		Scalar distance_drift              = distance_total - (2 * distance_accelerate);
+		Scalar time_drift                  = distance_drift / velocity_accelerate;
+		time_accelerate_anchors.time_drift = time_drift;
+	} else if (velocity_phase[1] <= 0 || distance_total / 2 <= jerk * (time_accelerate * time_accelerate * time_accelerate)) {
+		// don't have enough for full accelerate (calculate new accelerate max), even without retain the ramps alone would overshoot
+		Scalar time_accelerate_short = motion_profile_cbrt(distance_total / (2 * jerk));
+		time_accelerate_anchors      = {time_accelerate_short, 0, 0};
+	} else {
+		// have enough for full accelerate, but not retain
+		Scalar equation_a                   = (Scalar(1) / 2) * jerk * time_accelerate;
+		Scalar equation_b                   = (Scalar(3) / 2) * jerk * (time_accelerate * time_accelerate);
+		Scalar equation_c                   = jerk * (time_accelerate * time_accelerate * time_accelerate);
+		Scalar time_retain                  = ((-1) * equation_b + motion_profile_sqrt(equation_b * equation_b - (4 * equation_a * (equation_c - (distance_total / 2))))) / (2 * equation_a);
+		time_accelerate_anchors.time_retain = time_retain;
+	}
+	return time_accelerate_anchors;
+}
+
+template <typename Scalar>
+constexpr void sigmoid_phase_anchors_time(Scalar distance_total, Scalar velocity_max, Scalar acceleration_max, Scalar jerk, typename BasicSigmoidMotionProfile<Scalar>::SigmoidPhaseAnchors (&phase_anchors)[7]) noexcept {
+	SigmoidPhaseDurations<Scalar> time_accelerate_anchors = sigmoid_phase_durations(distance_total, velocity_max, acceleration_max, jerk);
+	// restructure result (distances are filled in by the constructor)
+	Scalar phases_time_full[7] = {
+		time_accelerate_anchors.time_accelerate, time_accelerate_anchors.time_retain, time_accelerate_anchors.time_accelerate,
+		time_accelerate_anchors.time_drift,
+		time_accelerate_anchors.time_accelerate, time_accelerate_anchors.time_retain, time_accelerate_anchors.time_accelerate
+	};
+	Scalar time_phase_accumulate = 0;
+	for (int phase_index = 0; phase_index < 7; phase_index++) {
+		phase_anchors[phase_index] = {
+			time_phase_accumulate,                                 // Scalar time_phase_begin;       (time the phase begins)
+			phases_time_full[phase_index],                         // Scalar time_phase_section;     (time the phase last)
+			time_phase_accumulate + phases_time_full[phase_index], // Scalar time_phase_end;         (time the phase ends)
+			0,                                                     // Scalar distance_phase_begin;   (distance the phase begins)
+			0,                                                     // Scalar distance_phase_section; (distance the phase last)
+			0                                                      // Scalar distance_phase_end;     (distance the phase ends)
+		};
+		time_phase_accumulate += phases_time_full[phase_index];
+	}
+}
+
+template <typename Scalar>
+constexpr void sigmoid_phase_anchors_boundary(Scalar distance_total, Scalar velocity_begin, Scalar velocity_end, Scalar velocity_max, Scalar acceleration_max, Scalar jerk, typename BasicSigmoidMotionProfile<Scalar>::SigmoidPhaseAnchors (&phase_anchors)[7]) noexcept {
+	// double s move between two non-zero velocities (biagiotti and melchiorri). both velocities are at most the velocity
+	// limit and the distance allows changing from one to the other, which the caller ensures
+	Scalar time_jerk_accelerate = 0;
+	Scalar time_accelerate      = 0;
+	Scalar time_jerk_decelerate = 0;
+	Scalar time_decelerate      = 0;
+	Scalar time_drift           = 0;
+	// assume the velocity limit is reached
+	if ((velocity_max - velocity_begin) * jerk < acceleration_max * acceleration_max) {
+		time_jerk_accelerate = motion_profile_sqrt((velocity_max - velocity_begin) / jerk);
+		time_accelerate      = 2 * time_jerk_accelerate;
+	} else {
+		time_jerk_accelerate = acceleration_max / jerk;
+		time_accelerate      = time_jerk_accelerate + (velocity_max - velocity_begin) / acceleration_max;
+	}
+	if ((velocity_max - velocity_end) * jerk < acceleration_max * acceleration_max) {
+		time_jerk_decelerate = motion_profile_sqrt((velocity_max - velocity_end) / jerk);
+		time_decelerate      = 2 * time_jerk_decelerate;
+	} else {
+		time_jerk_decelerate = acceleration_max / jerk;
+		time_decelerate      = time_jerk_decelerate + (velocity_max - velocity_end) / acceleration_max;
+	}
+	time_drift = distance_total / velocity_max - time_accelerate / 2 * (1 + velocity_begin / velocity_max) - time_decelerate / 2 * (1 + velocity_end / velocity_max);
+	if (time_drift <= 0) {
+		// the velocity limit is not reached. the ramps are solved for an acceleration limit that both of them reach, the
+		// largest such fraction of the given limit is bisected (a ramp that vanishes ends the search with a one sided move)
+		time_drift = 0;
+		Scalar velocity_sum      = velocity_begin + velocity_end;
+		bool   fraction_one_side = false;
+		auto   shape_solve       = [&](Scalar fraction) {
+			Scalar acceleration_reduced = fraction * acceleration_max;
+			Scalar time_jerk            = acceleration_reduced / jerk;
+			Scalar shape_delta          = acceleration_reduced * acceleration_reduced * acceleration_reduced * acceleration_reduced / (jerk * jerk) + 2 * (velocity_begin * velocity_begin + velocity_end * velocity_end) + acceleration_reduced * (4 * distance_total - 2 * time_jerk * velocity_sum);
+			Scalar shape_root           = motion_profile_sqrt(std::max(shape_delta, Scalar(0)));
+			time_jerk_accelerate = time_jerk;
+			time_jerk_decelerate = time_jerk;
+			time_accelerate      = (acceleration_reduced * acceleration_reduced / jerk - 2 * velocity_begin + shape_root) / (2 * acceleration_reduced);
+			time_decelerate      = (acceleration_reduced * acceleration_reduced / jerk - 2 * velocity_end + shape_root) / (2 * acceleration_reduced);
+			fraction_one_side    = (time_accelerate < 0 || time_decelerate < 0);
+			return fraction_one_side || (time_accelerate >= 2 * time_jerk && time_decelerate >= 2 * time_jerk);
+		};
+		if (!shape_solve(Scalar(1))) {
+			Scalar fraction_low  = 0;
+			Scalar fraction_high = 1;
+			for (int iteration = 0; iteration < SIGMOID_BOUNDARY_SHAPE_ITERATIONS; iteration++) {
+				Scalar fraction = (fraction_low + fraction_high) / 2;
+				if (shape_solve(fraction)) fraction_low  = fraction;
+				else                       fraction_high = fraction;
+			}
+			shape_solve(fraction_low);
+		}
+		if (fraction_one_side && time_accelerate < 0) {
+			// only decelerates
+			time_jerk_accelerate = 0;
+			time_accelerate      = 0;
+			time_decelerate      = 2 * distance_total / velocity_sum;
+			time_jerk_decelerate = (jerk * distance_total - motion_profile_sqrt(std::max(jerk * (jerk * distance_total * distance_total + velocity_sum * velocity_sum * (velocity_end - velocity_begin)), Scalar(0)))) / (jerk * velocity_sum);
+		} else if (fraction_one_side) {
+			// only accelerates
+			time_jerk_decelerate = 0;
+			time_decelerate      = 0;
+			time_accelerate      = 2 * distance_total / velocity_sum;
+			time_jerk_accelerate = (jerk * distance_total - motion_profile_sqrt(std::max(jerk * (jerk * distance_total * distance_total - velocity_sum * velocity_sum * (velocity_end - velocity_begin)), Scalar(0)))) / (jerk * velocity_sum);
+		}
+	}
+	// restructure result (distances are filled in by sigmoid_phase_integrate)
+	Scalar phases_time_full[7] = {
+		time_jerk_accelerate, time_accelerate - 2 * time_jerk_accelerate, time_jerk_accelerate,
+		time_drift,
+		time_jerk_decelerate, time_decelerate - 2 * time_jerk_decelerate, time_jerk_decelerate
+	};
+	Scalar time_phase_accumulate = 0;
+	for (int phase_index = 0; phase_index < 7; phase_index++) {
+		Scalar phase_time_section  = std::max(phases_time_full[phase_index], Scalar(0));
+		phase_anchors[phase_index] = {time_phase_accumulate, phase_time_section, time_phase_accumulate + phase_time_section, 0, 0, 0};
+		time_phase_accumulate     += phase_time_section;
+	}
+}
+
+template <typename Scalar>
+constexpr void sigmoid_phase_integrate(Scalar jerk, Scalar velocity_begin, typename BasicSigmoidMotionProfile<Scalar>::SigmoidPhaseAnchors (&phase_anchors)[7], BasicMotionProfileSegment<Scalar> (&phase_segments)[7]) noexcept {
+	// integrate the jerk of each phase from zero distance and acceleration at velocity_begin (fills the polynomials and distances)
+	const Scalar phase_jerk[7] = {jerk, 0, (-1) * jerk, 0, (-1) * jerk, 0, jerk};
+	Scalar distance_phase_begin     = 0;
+	Scalar velocity_phase_begin     = velocity_begin;
+	Scalar acceleration_phase_begin = 0;
+	for (int phase_index = 0; phase_index < 7; phase_index++) {
+		typename BasicSigmoidMotionProfile<Scalar>::SigmoidPhaseAnchors& phase_anchor = phase_anchors[phase_index];
+		Scalar                                                           time_section = phase_anchor.time_phase_section;
+		phase_segments[phase_index] = {
+			phase_anchor.time_phase_begin,              // Scalar time_begin;
+			(Scalar(1) / 6) * phase_jerk[phase_index],  // Scalar cubic_degree_third;  (jerk / 6)
+			(Scalar(1) / 2) * acceleration_phase_begin, // Scalar cubic_degree_second; (acceleration / 2)
+			velocity_phase_begin,                       // Scalar cubic_degree_first;  (velocity)
+			distance_phase_begin                        // Scalar cubic_degree_zero;   (distance)
+		};
+		Scalar distance_phase_end = distance_phase_begin + ((phase_jerk[phase_index] / 6 * time_section + acceleration_phase_begin / 2) * time_section + velocity_phase_begin) * time_section;
+		phase_anchor.distance_phase_begin   = distance_phase_begin;
+		phase_anchor.distance_phase_section = distance_phase_end - distance_phase_begin;
+		phase_anchor.distance_phase_end     = distance_phase_end;
+		distance_phase_begin      = distance_phase_end;
+		velocity_phase_begin     += acceleration_phase_begin * time_section + (Scalar(1) / 2) * phase_jerk[phase_index] * time_section * time_section;
+		acceleration_phase_begin += phase_jerk[phase_index] * time_section;
+	}
+}
+
+// roots of a cubic in fixed storage (the first root_count are set)
+struct SigmoidCubicRoots {
+	std::complex<float> roots[3];
+	int                 root_count;
+};
+
+SigmoidCubicRoots sigmoid_cubic_solve(SigmoidMotionProfile::SigmoidCubicConstants sigmoid_cubic_constants) noexcept;
\ No newline at end of file
@@ -0,0 +1,79 @@
+#include <cmath>
+#include <iterator>
+#include <algorithm>
+#include "motion_profile_sigmoid_cache.h"
+
+SigmoidMotionProfileCache::SigmoidMotionProfileCache(size_t capacity, float tolerance) {
+	// a cache holds at least one profile, and the tolerance is a relative quantum in (0, 1) (the default otherwise), as
+	// every key divides by it
+	this->capacity  = std::max(capacity, (size_t) 1);
+	this->tolerance = (tolerance > 0 && tolerance < 1 ? tolerance : SIGMOID_CACHE_TOLERANCE_DEFAULT);
+	this->entry_index.reserve(this->capacity);
+}
+
+std::shared_ptr<const SigmoidMotionProfile> SigmoidMotionProfileCache::get_profile(float distance_total, float velocity_max, float acceleration_max, float jerk) {
+	float           parameters[4] = {distance_total, velocity_max, acceleration_max, jerk};
+	SigmoidCacheKey key;
+	bool            key_valid     = true;
+	for (int parameter_index = 0; parameter_index < 4; parameter_index++) {
+		// the mantissa in [0.5, 1) is rounded to steps of the tolerance, which keeps the error relative to the value
+		int    parameter_exponent = 0;
+		double parameter_mantissa = (std::isfinite(parameters[parameter_index]) ? std::frexp((double) parameters[parameter_index], &parameter_exponent) : 0.0);
+		double parameter_steps    = parameter_mantissa / this->tolerance;
+		// zero or non-finite parameters, or more steps than the key holds, cannot be rounded into a key
+		key_valid = key_valid && parameter_steps != 0 && std::fabs(parameter_steps) < SIGMOID_CACHE_STEPS_MAX;
+		key.parameter_steps[parameter_index]     = (key_valid ? std::llround(parameter_steps) : 0);
+		key.parameter_exponents[parameter_index] = parameter_exponent;
+	}
+	std::lock_guard<std::mutex> cache_lock(this->cache_mutex);
+	if (!key_valid) {
+		// built as asked and never stored, rather than sharing a key with other moves
+		this->miss_count++;
+		return std::make_shared<const SigmoidMotionProfile>(distance_total, velocity_max, acceleration_max, jerk);
+	}
+	auto entry_found = this->entry_index.find(key);
+	if (entry_found != this->entry_index.end()) {
+		this->hit_count++;
+		this->entries.splice(this->entries.begin(), this->entries, entry_found->second);
+		return entry_found->second->profile;
+	}
+	this->miss_count++;
+	// the slot of the least recently used profile is reused for the new one
+	if (this->entries.size() >= this->capacity) {
+		this->eviction_count++;
+		this->entry_index.erase(this->entries.back().key);
+		this->entries.splice(this->entries.begin(), this->entries, std::prev(this->entries.end()));
+	} else {
+		this->entries.emplace_front();
+	}
+	for (int parameter_index = 0; parameter_index < 4; parameter_index++) parameters[parameter_index] = (float) std::ldexp(key.parameter_steps[parameter_index] * (double) this->tolerance, key.parameter_exponents[parameter_index]);
+	this->entries.front().key     = key;
+	this->entries.front().profile = std::make_shared<const SigmoidMotionProfile>(parameters[0], parameters[1], parameters[2], parameters[3]);
+	this->entry_index.emplace(key, this->entries.begin());
+	return this->entries.front().profile;
+}
+
+SigmoidMotionProfileCache::SigmoidCacheCounters SigmoidMotionProfileCache::get_counters() const {
+	std::lock_guard<std::mutex> cache_lock(this->cache_mutex);
+	return {this->hit_count, this->miss_count, this->eviction_count, this->entries.size()};
+}
+
+void SigmoidMotionProfileCache::clear() {
+	std::lock_guard<std::mutex> cache_lock(this->cache_mutex);
+	this->entry_index.clear();
+	this->entries.clear();
+}
+
+bool SigmoidMotionProfileCache::SigmoidCacheKey::operator==(const SigmoidCacheKey& other) const {
+	return std::equal(this->parameter_steps, this->parameter_steps + 4, other.parameter_steps) && std::equal(this->parameter_exponents, this->parameter_exponents + 4, other.parameter_exponents);
+}
+
+size_t SigmoidMotionProfileCache::SigmoidCacheKeyHash::operator()(const SigmoidCacheKey& key) const {
+	// 64 bit fnv-1a style mix of the four steps and exponents
+	uint64_t key_hash = 14695981039346656037ull;
+	for (int parameter_index = 0; parameter_index < 4; parameter_index++) {
+		key_hash = (key_hash ^ (uint64_t) key.parameter_steps[parameter_index]) * 1099511628211ull;
+		key_hash = (key_hash ^ (uint64_t) (uint32_t) key.parameter_exponents[parameter_index]) * 1099511628211ull;
+	}
+	return (size_t) (key_hash ^ (key_hash >> 32));
+}
\ No newline at end of file
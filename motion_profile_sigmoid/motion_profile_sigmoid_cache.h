@@ -0,0 +1,58 @@
+#pragma once
+#include <list>
+#include <mutex>
+#include <memory>
+#include <cstdint>
+#include <cstddef>
+#include <unordered_map>
+#include "motion_profile_sigmoid.h"
+
+#define SIGMOID_CACHE_CAPACITY_DEFAULT  1024   // profiles kept before the least recently used one is evicted
+#define SIGMOID_CACHE_TOLERANCE_DEFAULT 1e-4f  // relative quantum the move parameters are rounded to
+#define SIGMOID_CACHE_STEPS_MAX         4.6e18 // parameters of more quanta than this bypass the cache (below 2^62)
+
+// bounded, thread safe store of sigmoid profiles shared between everyone asking for the same move. parameters are
+// rounded to within the tolerance of their own magnitude (the mantissa to a multiple of it) and the profile is built
+// from the rounded values, so every parameter set of one key gets the very same profile no matter which of them missed
+// first. moves with a zero parameter are built as asked and not stored.
+class SigmoidMotionProfileCache {
+public:
+	struct SigmoidCacheCounters {
+		unsigned long long hit_count;
+		unsigned long long miss_count;
+		unsigned long long eviction_count;
+		size_t             entry_count;
+	};
+
+	SigmoidMotionProfileCache                                      (size_t capacity = SIGMOID_CACHE_CAPACITY_DEFAULT, float tolerance = SIGMOID_CACHE_TOLERANCE_DEFAULT); // a zero capacity keeps one, an invalid tolerance takes the default
+	SigmoidMotionProfileCache                                      (const SigmoidMotionProfileCache&) = delete;
+	SigmoidMotionProfileCache&                  operator=          (const SigmoidMotionProfileCache&) = delete;
+	// profiles handed out stay valid after their eviction
+	std::shared_ptr<const SigmoidMotionProfile> get_profile        (float distance_total, float velocity_max, float acceleration_max, float jerk);
+	SigmoidCacheCounters                        get_counters       () const;
+	void                                        clear              (); // drops every profile, the counters are kept
+private:
+	struct SigmoidCacheKey {
+		int64_t parameter_steps[4];     // mantissas of distance, velocity, acceleration and jerk in multiples of the tolerance
+		int     parameter_exponents[4]; // their binary exponents
+		bool operator== (const SigmoidCacheKey& other) const;
+	};
+
+	struct SigmoidCacheKeyHash {
+		size_t operator() (const SigmoidCacheKey& key) const;
+	};
+
+	struct SigmoidCacheEntry {
+		SigmoidCacheKey                             key;
+		std::shared_ptr<const SigmoidMotionProfile> profile;
+	};
+
+	size_t                                                                                           capacity;
+	float                                                                                            tolerance;
+	mutable std::mutex                                                                               cache_mutex;
+	std::list<SigmoidCacheEntry>                                                                     entries; // most recently used first
+	std::unordered_map<SigmoidCacheKey, std::list<SigmoidCacheEntry>::iterator, SigmoidCacheKeyHash> entry_index;
+	unsigned long long                                                                               hit_count      = 0;
+	unsigned long long                                                                               miss_count     = 0;
+	unsigned long long                                                                               eviction_count = 0;
+};
\ No newline at end of file
@@ -0,0 +1,106 @@
+#include "motion_profile_sigmoid_duration.h"
+#include "../motion_profile_segment/motion_profile_segment_simd.h"
+
+#define SIGMOID_DURATION_CBRT_ITERATIONS 4 // newton steps of the simd cube root (from a seed within a few percent)
+
+void sigmoid_duration_batch_scalar(SigmoidLimitColumns move_limits, size_t move_begin, size_t move_end, SigmoidDurationColumns move_durations) noexcept;
+#ifdef MOTION_PROFILE_SEGMENT_X86
+void sigmoid_duration_batch_avx2(SigmoidLimitColumns move_limits, size_t move_count, SigmoidDurationColumns move_durations) noexcept;
+#endif
+
+MotionProfileBatchKernel sigmoid_duration_batch_kernel(MotionProfileBatchKernel batch_kernel) noexcept {
+	// never a kernel the cpu does not support, and only avx2 has one of its own
+	if ((int) batch_kernel > (int) motion_profile_batch_kernel_supported()) batch_kernel = motion_profile_batch_kernel_supported();
+#ifdef MOTION_PROFILE_SEGMENT_X86
+	if (batch_kernel == MotionProfileBatchKernel::AVX2) return MotionProfileBatchKernel::AVX2;
+#endif
+	return MotionProfileBatchKernel::SCALAR;
+}
+
+void sigmoid_duration_batch(SigmoidLimitColumns move_limits, size_t move_count, SigmoidDurationColumns move_durations, MotionProfileBatchKernel batch_kernel) noexcept {
+#ifdef MOTION_PROFILE_SEGMENT_X86
+	if (sigmoid_duration_batch_kernel(batch_kernel) == MotionProfileBatchKernel::AVX2) {
+		sigmoid_duration_batch_avx2(move_limits, move_count, move_durations);
+		return;
+	}
+#endif
+	sigmoid_duration_batch_scalar(move_limits, 0, move_count, move_durations);
+}
+
+void sigmoid_duration_batch_scalar(SigmoidLimitColumns move_limits, size_t move_begin, size_t move_end, SigmoidDurationColumns move_durations) noexcept {
+	for (size_t move_index = move_begin; move_index < move_end; move_index++) {
+		SigmoidPhaseDurations<float> phase_durations = sigmoid_phase_durations(move_limits.distance_total[move_index], move_limits.velocity_max[move_index], move_limits.acceleration_max[move_index], move_limits.jerk[move_index]);
+		float time_accelerate = phase_durations.time_accelerate;
+		float time_retain     = phase_durations.time_retain;
+		if (move_durations.time_accelerate != nullptr) move_durations.time_accelerate[move_index] = time_accelerate;
+		if (move_durations.time_retain != nullptr)     move_durations.time_retain[move_index]     = time_retain;
+		if (move_durations.time_drift != nullptr)      move_durations.time_drift[move_index]      = phase_durations.time_drift;
+		// summed phase by phase like the profile anchors, so the end matches get_time_end
+		if (move_durations.time_end != nullptr)        move_durations.time_end[move_index]        = time_accelerate + time_retain + time_accelerate + phase_durations.time_drift + time_accelerate + time_retain + time_accelerate;
+	}
+}
+
+#ifdef MOTION_PROFILE_SEGMENT_X86
+MOTION_PROFILE_TARGET_AVX2 __m256 sigmoid_duration_cbrt_avx2(__m256 value) noexcept {
+	// seed from the exponent bits divided by three, then newton on root^3 = value
+	__m256i value_bits = _mm256_castps_si256(value);
+	__m256i root_bits  = _mm256_add_epi32(_mm256_cvttps_epi32(_mm256_mul_ps(_mm256_cvtepi32_ps(value_bits), _mm256_set1_ps(1.0f / 3))), _mm256_set1_epi32(709921077));
+	__m256  root       = _mm256_castsi256_ps(root_bits);
+	for (int iteration = 0; iteration < SIGMOID_DURATION_CBRT_ITERATIONS; iteration++) {
+		root = _mm256_mul_ps(_mm256_add_ps(_mm256_add_ps(root, root), _mm256_div_ps(value, _mm256_mul_ps(root, root))), _mm256_set1_ps(1.0f / 3));
+	}
+	return _mm256_blendv_ps(root, _mm256_setzero_ps(), _mm256_cmp_ps(value, _mm256_setzero_ps(), _CMP_EQ_OQ));
+}
+
+MOTION_PROFILE_TARGET_AVX2 void sigmoid_duration_batch_avx2(SigmoidLimitColumns move_limits, size_t move_count, SigmoidDurationColumns move_durations) noexcept {
+	// every branch of sigmoid_phase_durations for eight moves at once, in the same order of operations, then blended
+	const __m256 zero  = _mm256_setzero_ps();
+	const __m256 half  = _mm256_set1_ps(1.0f / 2);
+	const __m256 sixth = _mm256_set1_ps(1.0f / 6);
+	size_t move_index = 0;
+	for (; move_index + 8 <= move_count; move_index += 8) {
+		__m256 distance_total   = _mm256_loadu_ps(move_limits.distance_total + move_index);
+		__m256 velocity_max     = _mm256_loadu_ps(move_limits.velocity_max + move_index);
+		__m256 acceleration_max = _mm256_loadu_ps(move_limits.acceleration_max + move_index);
+		__m256 jerk             = _mm256_loadu_ps(move_limits.jerk + move_index);
+		__m256 distance_half    = _mm256_div_ps(distance_total, _mm256_set1_ps(2.0f));
+		// limits and the longest retain
+		__m256 time_accelerate  = _mm256_min_ps(_mm256_div_ps(acceleration_max, jerk), _mm256_div_ps(velocity_max, acceleration_max));
+		__m256 time_square      = _mm256_mul_ps(time_accelerate, time_accelerate);
+		__m256 time_cube        = _mm256_mul_ps(time_square, time_accelerate);
+		__m256 jerk_time        = _mm256_mul_ps(jerk, time_accelerate);
+		__m256 time_retain      = _mm256_max_ps(_mm256_div_ps(_mm256_sub_ps(velocity_max, _mm256_mul_ps(jerk, time_square)), jerk_time), zero);
+		// velocity and distance of the three accelerate phases
+		__m256 velocity_ramp    = _mm256_mul_ps(_mm256_mul_ps(half, jerk), time_square);
+		__m256 velocity_retain  = _mm256_mul_ps(jerk_time, time_retain);
+		__m256 velocity_release = _mm256_sub_ps(_mm256_mul_ps(jerk_time, time_accelerate), velocity_ramp);
+		__m256 distance_ramp    = _mm256_mul_ps(_mm256_mul_ps(sixth, jerk), time_cube);
+		__m256 distance_retain  = _mm256_add_ps(_mm256_mul_ps(_mm256_mul_ps(half, jerk_time), _mm256_mul_ps(time_retain, time_retain)), _mm256_mul_ps(velocity_ramp, time_retain));
+		__m256 distance_release = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(_mm256_mul_ps(_mm256_set1_ps(-1.0f / 6), jerk), time_cube), _mm256_mul_ps(_mm256_mul_ps(half, jerk_time), time_square)), _mm256_mul_ps(_mm256_add_ps(velocity_ramp, velocity_retain), time_accelerate));
+		__m256 distance_accelerate = _mm256_add_ps(_mm256_add_ps(distance_ramp, distance_retain), distance_release);
+		__m256 velocity_accelerate = _mm256_add_ps(_mm256_add_ps(velocity_ramp, velocity_retain), velocity_release);
+		// cruise, ramps only, or full ramps with a shortened retain
+		__m256 mask_drift = _mm256_cmp_ps(distance_half, distance_accelerate, _CMP_GT_OQ);
+		__m256 mask_short = _mm256_andnot_ps(mask_drift, _mm256_or_ps(_mm256_cmp_ps(velocity_retain, zero, _CMP_LE_OQ), _mm256_cmp_ps(distance_half, _mm256_mul_ps(jerk, time_cube), _CMP_LE_OQ)));
+		__m256 time_drift  = _mm256_div_ps(_mm256_sub_ps(distance_total, _mm256_mul_ps(_mm256_set1_ps(2.0f), distance_accelerate)), velocity_accelerate);
+		__m256 time_short  = sigmoid_duration_cbrt_avx2(_mm256_div_ps(distance_total, _mm256_mul_ps(_mm256_set1_ps(2.0f), jerk)));
+		__m256 equation_a  = _mm256_mul_ps(_mm256_mul_ps(half, jerk), time_accelerate);
+		__m256 equation_b  = _mm256_mul_ps(_mm256_mul_ps(_mm256_set1_ps(3.0f / 2), jerk), time_square);
+		__m256 equation_c  = _mm256_mul_ps(jerk, time_cube);
+		__m256 root        = _mm256_sqrt_ps(_mm256_sub_ps(_mm256_mul_ps(equation_b, equation_b), _mm256_mul_ps(_mm256_mul_ps(_mm256_set1_ps(4.0f), equation_a), _mm256_sub_ps(equation_c, distance_half))));
+		__m256 time_retain_shortened = _mm256_div_ps(_mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(-1.0f), equation_b), root), _mm256_mul_ps(_mm256_set1_ps(2.0f), equation_a));
+		time_retain     = _mm256_blendv_ps(_mm256_blendv_ps(time_retain_shortened, zero, mask_short), time_retain, mask_drift);
+		time_drift      = _mm256_and_ps(time_drift, mask_drift);
+		time_accelerate = _mm256_blendv_ps(time_accelerate, time_short, mask_short);
+		if (move_durations.time_accelerate != nullptr) _mm256_storeu_ps(move_durations.time_accelerate + move_index, time_accelerate);
+		if (move_durations.time_retain != nullptr)     _mm256_storeu_ps(move_durations.time_retain + move_index,     time_retain);
+		if (move_durations.time_drift != nullptr)      _mm256_storeu_ps(move_durations.time_drift + move_index,      time_drift);
+		if (move_durations.time_end != nullptr) {
+			__m256 time_end = _mm256_add_ps(_mm256_add_ps(_mm256_add_ps(time_accelerate, time_retain), time_accelerate), time_drift);
+			time_end        = _mm256_add_ps(_mm256_add_ps(_mm256_add_ps(time_end, time_accelerate), time_retain), time_accelerate);
+			_mm256_storeu_ps(move_durations.time_end + move_index, time_end);
+		}
+	}
+	sigmoid_duration_batch_scalar(move_limits, move_index, move_count, move_durations);
+}
+#endif
\ No newline at end of file
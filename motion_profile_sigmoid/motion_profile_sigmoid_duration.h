@@ -0,0 +1,26 @@
+#pragma once
+#include <cstddef>
+#include "motion_profile_sigmoid.h"
+
+// limits of many rest to rest moves as columns (structure of arrays), one value per move in each
+struct SigmoidLimitColumns {
+	const float* distance_total;
+	const float* velocity_max;
+	const float* acceleration_max;
+	const float* jerk;
+};
+
+// phase durations of many moves as columns (null columns are skipped), see SigmoidPhaseDurations
+struct SigmoidDurationColumns {
+	float* time_accelerate;
+	float* time_retain;
+	float* time_drift;
+	float* time_end;
+};
+
+// durations of move_count moves without building their profiles, for searching limit sets at planning time. the
+// results are those of SigmoidMotionProfile (time_end matches get_time_end), the simd kernels take the cube root by
+// newton steps and may differ from it in the last place. sse4.1 runs the scalar kernel
+void                     sigmoid_duration_batch        (SigmoidLimitColumns move_limits, size_t move_count, SigmoidDurationColumns move_durations, MotionProfileBatchKernel batch_kernel = motion_profile_batch_kernel_supported()) noexcept;
+// the kernel sigmoid_duration_batch actually runs when asked for batch_kernel
+MotionProfileBatchKernel sigmoid_duration_batch_kernel (MotionProfileBatchKernel batch_kernel) noexcept;
\ No newline at end of file
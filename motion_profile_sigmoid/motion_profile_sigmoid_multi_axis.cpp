@@ -0,0 +1,157 @@
+#include <cmath>
+#include <algorithm>
+#include "motion_profile_sigmoid_multi_axis.h"
+
+#define SIGMOID_MULTI_AXIS_SOLVE_ITERATIONS 64      // cap of the velocity limit search (it converges in a handful)
+#define SIGMOID_MULTI_AXIS_SOLVE_TOLERANCE  1e-9    // relative duration error the search stops at
+#define SIGMOID_MULTI_AXIS_PLAN_CHUNK       64      // moves per thread pool chunk
+
+double sigmoid_multi_axis_duration (double distance, double velocity_max, double acceleration_max, double jerk);
+double sigmoid_multi_axis_stretch  (double distance, double velocity_max, double acceleration_max, double jerk, double time_target);
+
+SigmoidMultiAxisProfile::SigmoidMultiAxisProfile() : SigmoidMultiAxisProfile(nullptr, 0) {}
+
+SigmoidMultiAxisProfile::SigmoidMultiAxisProfile(const SigmoidAxisLimits* axis_limits, int axis_count) {
+	this->axis_count = std::min(std::max(axis_count, 0), SIGMOID_MULTI_AXIS_COUNT_MAX);
+	this->time_end   = 0.0f;
+	for (int phase_index = 0; phase_index < 7; phase_index++) {
+		for (int axis_index = 0; axis_index < SIGMOID_MULTI_AXIS_COUNT_MAX; axis_index++) {
+			this->phase_time_begin[phase_index][axis_index]   = 0.0f;
+			this->phase_cubic_third[phase_index][axis_index]  = 0.0f;
+			this->phase_cubic_second[phase_index][axis_index] = 0.0f;
+			this->phase_cubic_first[phase_index][axis_index]  = 0.0f;
+			this->phase_cubic_zero[phase_index][axis_index]   = 0.0f;
+		}
+	}
+	for (int axis_index = 0; axis_index < SIGMOID_MULTI_AXIS_COUNT_MAX; axis_index++) {
+		this->axis_limits[axis_index]   = (axis_index < this->axis_count ? axis_limits[axis_index] : SigmoidAxisLimits{0.0f, 0.0f, 0.0f, 0.0f});
+		this->axis_time_end[axis_index] = 0.0f;
+	}
+	// the slowest axis sets the duration (in double, the stretch solve compares against it)
+	double axis_duration[SIGMOID_MULTI_AXIS_COUNT_MAX] = {};
+	double time_target                                 = 0.0;
+	for (int axis_index = 0; axis_index < this->axis_count; axis_index++) {
+		const SigmoidAxisLimits& axis_limit = this->axis_limits[axis_index];
+		if (axis_limit.distance == 0.0f) continue;
+		axis_duration[axis_index] = sigmoid_multi_axis_duration(std::fabs(axis_limit.distance), axis_limit.velocity_max, axis_limit.acceleration_max, axis_limit.jerk);
+		time_target               = std::max(time_target, axis_duration[axis_index]);
+	}
+	// stretch the others to it and pack their phase polynomials
+	for (int axis_index = 0; axis_index < this->axis_count; axis_index++) {
+		SigmoidAxisLimits& axis_limit = this->axis_limits[axis_index];
+		if (axis_limit.distance == 0.0f) continue;
+		float distance_sign = (axis_limit.distance < 0.0f ? -1.0f : 1.0f);
+		if (axis_duration[axis_index] < time_target) {
+			axis_limit.velocity_max = (float) sigmoid_multi_axis_stretch(std::fabs(axis_limit.distance), axis_limit.velocity_max, axis_limit.acceleration_max, axis_limit.jerk, time_target);
+		}
+		SigmoidMotionProfile        axis_profile  = this->get_axis_profile(axis_index);
+		const MotionProfileSegment* axis_segments = axis_profile.get_segments();
+		for (int phase_index = 0; phase_index < 7; phase_index++) {
+			this->phase_time_begin[phase_index][axis_index]   = axis_segments[phase_index].time_begin;
+			this->phase_cubic_third[phase_index][axis_index]  = distance_sign * axis_segments[phase_index].cubic_degree_third;
+			this->phase_cubic_second[phase_index][axis_index] = distance_sign * axis_segments[phase_index].cubic_degree_second;
+			this->phase_cubic_first[phase_index][axis_index]  = distance_sign * axis_segments[phase_index].cubic_degree_first;
+			this->phase_cubic_zero[phase_index][axis_index]   = distance_sign * axis_segments[phase_index].cubic_degree_zero;
+		}
+		this->axis_time_end[axis_index] = axis_profile.get_time_end();
+		this->time_end                  = std::max(this->time_end, this->axis_time_end[axis_index]);
+	}
+}
+
+int SigmoidMultiAxisProfile::get_axis_count() const {
+	return this->axis_count;
+}
+
+SigmoidAxisLimits SigmoidMultiAxisProfile::get_axis_limits(int axis_index) const {
+	return this->axis_limits[axis_index];
+}
+
+SigmoidMotionProfile SigmoidMultiAxisProfile::get_axis_profile(int axis_index) const {
+	const SigmoidAxisLimits& axis_limit = this->axis_limits[axis_index];
+	return SigmoidMotionProfile(std::fabs(axis_limit.distance), axis_limit.velocity_max, axis_limit.acceleration_max, axis_limit.jerk);
+}
+
+float SigmoidMultiAxisProfile::get_time_end() const {
+	return this->time_end;
+}
+
+void SigmoidMultiAxisProfile::get_time_samples(float progress_time, MotionProfileSamples samples) const {
+	// every loop runs over all lanes (unused axes are zero) so the compiler can keep the axes side by side in vector registers
+	float time_section[SIGMOID_MULTI_AXIS_COUNT_MAX];
+	int   phase_index[SIGMOID_MULTI_AXIS_COUNT_MAX];
+	for (int axis_index = 0; axis_index < SIGMOID_MULTI_AXIS_COUNT_MAX; axis_index++) {
+		// axes that finished early (rounding of the stretch) hold their end point
+		time_section[axis_index] = std::min(std::max(progress_time, 0.0f), this->axis_time_end[axis_index]);
+		phase_index[axis_index]  = 0;
+	}
+	// phase begin times ascend, so the phase of a lane is the number of later phases it has reached
+	for (int phase_next = 1; phase_next < 7; phase_next++) {
+		for (int axis_index = 0; axis_index < SIGMOID_MULTI_AXIS_COUNT_MAX; axis_index++) phase_index[axis_index] += (time_section[axis_index] >= this->phase_time_begin[phase_next][axis_index]);
+	}
+	float cubic_third[SIGMOID_MULTI_AXIS_COUNT_MAX];
+	float cubic_second[SIGMOID_MULTI_AXIS_COUNT_MAX];
+	float cubic_first[SIGMOID_MULTI_AXIS_COUNT_MAX];
+	float cubic_zero[SIGMOID_MULTI_AXIS_COUNT_MAX];
+	for (int axis_index = 0; axis_index < SIGMOID_MULTI_AXIS_COUNT_MAX; axis_index++) {
+		int axis_phase            = phase_index[axis_index];
+		time_section[axis_index] -= this->phase_time_begin[axis_phase][axis_index];
+		cubic_third[axis_index]   = this->phase_cubic_third[axis_phase][axis_index];
+		cubic_second[axis_index]  = this->phase_cubic_second[axis_phase][axis_index];
+		cubic_first[axis_index]   = this->phase_cubic_first[axis_phase][axis_index];
+		cubic_zero[axis_index]    = this->phase_cubic_zero[axis_phase][axis_index];
+	}
+	if (samples.distance != nullptr) {
+		for (int axis_index = 0; axis_index < this->axis_count; axis_index++) samples.distance[axis_index] = ((cubic_third[axis_index] * time_section[axis_index] + cubic_second[axis_index]) * time_section[axis_index] + cubic_first[axis_index]) * time_section[axis_index] + cubic_zero[axis_index];
+	}
+	if (samples.velocity != nullptr) {
+		for (int axis_index = 0; axis_index < this->axis_count; axis_index++) samples.velocity[axis_index] = (3 * cubic_third[axis_index] * time_section[axis_index] + 2 * cubic_second[axis_index]) * time_section[axis_index] + cubic_first[axis_index];
+	}
+	if (samples.acceleration != nullptr) {
+		for (int axis_index = 0; axis_index < this->axis_count; axis_index++) samples.acceleration[axis_index] = 6 * cubic_third[axis_index] * time_section[axis_index] + 2 * cubic_second[axis_index];
+	}
+	if (samples.jerk != nullptr) {
+		for (int axis_index = 0; axis_index < this->axis_count; axis_index++) samples.jerk[axis_index] = 6 * cubic_third[axis_index];
+	}
+}
+
+void sigmoid_multi_axis_plan_batch(MotionProfileThreadPool& thread_pool, const SigmoidAxisLimits* move_axis_limits, int axis_count, size_t move_count, SigmoidMultiAxisProfile* move_profiles) {
+	thread_pool.parallel_for(move_count, SIGMOID_MULTI_AXIS_PLAN_CHUNK, [&](size_t move_begin, size_t move_end) {
+		for (size_t move_index = move_begin; move_index < move_end; move_index++) move_profiles[move_index] = SigmoidMultiAxisProfile(move_axis_limits + move_index * axis_count, axis_count);
+	});
+}
+
+double sigmoid_multi_axis_duration(double distance, double velocity_max, double acceleration_max, double jerk) {
+	SigmoidPhaseDurations<double> phase_durations = sigmoid_phase_durations(distance, velocity_max, acceleration_max, jerk);
+	return 4 * phase_durations.time_accelerate + 2 * phase_durations.time_retain + phase_durations.time_drift;
+}
+
+double sigmoid_multi_axis_stretch(double distance, double velocity_max, double acceleration_max, double jerk, double time_target) {
+	// the duration only grows as the velocity limit drops. it is close to linear in the pace (inverse velocity limit)
+	// once the move cruises, so the root is searched in the pace with regula falsi (illinois), which keeps it bracketed.
+	// the pace that covers the whole distance at full speed in the target time is always slow enough
+	double pace_low   = 1.0 / velocity_max;
+	double pace_high  = std::max(time_target / distance, pace_low);
+	double error_low  = sigmoid_multi_axis_duration(distance, 1.0 / pace_low, acceleration_max, jerk) - time_target;
+	double error_high = sigmoid_multi_axis_duration(distance, 1.0 / pace_high, acceleration_max, jerk) - time_target;
+	if (error_low >= 0.0) return velocity_max;
+	if (error_high <= 0.0) return 1.0 / pace_high;
+	double pace      = pace_high;
+	int    pace_side = 0; // side of the bracket that moved last
+	for (int iteration = 0; iteration < SIGMOID_MULTI_AXIS_SOLVE_ITERATIONS; iteration++) {
+		pace = (pace_low * error_high - pace_high * error_low) / (error_high - error_low);
+		double error = sigmoid_multi_axis_duration(distance, 1.0 / pace, acceleration_max, jerk) - time_target;
+		if (std::fabs(error) <= SIGMOID_MULTI_AXIS_SOLVE_TOLERANCE * time_target) break;
+		if (error > 0.0) {
+			pace_high  = pace;
+			error_high = error;
+			if (pace_side > 0) error_low /= 2;
+			pace_side  = 1;
+		} else {
+			pace_low   = pace;
+			error_low  = error;
+			if (pace_side < 0) error_high /= 2;
+			pace_side  = -1;
+		}
+	}
+	return 1.0 / pace;
+}
\ No newline at end of file
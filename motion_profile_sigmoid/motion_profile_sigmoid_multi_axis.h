@@ -0,0 +1,42 @@
+#pragma once
+#include <cstddef>
+#include "motion_profile_sigmoid.h"
+#include "../motion_profile_parallel/motion_profile_parallel.h"
+
+#define SIGMOID_MULTI_AXIS_COUNT_MAX 8 // axes per move (lanes of the packed evaluation)
+
+// limits of one axis of a move. the distance is signed, the limits are magnitudes
+struct SigmoidAxisLimits {
+	float distance;
+	float velocity_max;
+	float acceleration_max;
+	float jerk;
+};
+
+// sigmoid profiles for up to eight axes that start and finish together. the axis that takes longest keeps its limits,
+// every other axis gets the velocity limit that stretches its own profile to the same duration. the phase polynomials
+// of all axes are packed phase by phase so a control tick evaluates every axis in one pass.
+class SigmoidMultiAxisProfile {
+public:
+	SigmoidMultiAxisProfile                   (); // no axes, for filling arrays of planned moves
+	SigmoidMultiAxisProfile                   (const SigmoidAxisLimits* axis_limits, int axis_count);
+	int                  get_axis_count       () const;
+	SigmoidAxisLimits    get_axis_limits      (int axis_index) const; // limits after stretching
+	SigmoidMotionProfile get_axis_profile     (int axis_index) const; // profile of the unsigned distance
+	float                get_time_end         () const;
+	void                 get_time_samples     (float progress_time, MotionProfileSamples samples) const; // one value per axis in each column
+private:
+	int               axis_count;
+	float             time_end;
+	SigmoidAxisLimits axis_limits[SIGMOID_MULTI_AXIS_COUNT_MAX];
+	float             axis_time_end[SIGMOID_MULTI_AXIS_COUNT_MAX];
+	// phase polynomials of every axis with the distance sign applied, [phase][axis] (unused axes stay zero)
+	float             phase_time_begin[7][SIGMOID_MULTI_AXIS_COUNT_MAX];
+	float             phase_cubic_third[7][SIGMOID_MULTI_AXIS_COUNT_MAX];
+	float             phase_cubic_second[7][SIGMOID_MULTI_AXIS_COUNT_MAX];
+	float             phase_cubic_first[7][SIGMOID_MULTI_AXIS_COUNT_MAX];
+	float             phase_cubic_zero[7][SIGMOID_MULTI_AXIS_COUNT_MAX];
+};
+
+// plans move_count moves of axis_count axes each (move_axis_limits holds axis_count limits per move, back to back)
+void sigmoid_multi_axis_plan_batch(MotionProfileThreadPool& thread_pool, const SigmoidAxisLimits* move_axis_limits, int axis_count, size_t move_count, SigmoidMultiAxisProfile* move_profiles);
\ No newline at end of file
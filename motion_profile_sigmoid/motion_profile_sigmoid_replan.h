@@ -0,0 +1,192 @@
+#pragma once
+#include <algorithm>
+#include "motion_profile_sigmoid.h"
+
+#define SIGMOID_REPLAN_SEGMENT_COUNT_MAX 11 // acceleration release, one velocity ramp and a double s move
+
+// jerk limited move from any state (distance, velocity, acceleration) to rest at a target, for replanning while moving.
+// the plan releases the acceleration first, then either stops and reverses (the target can no longer be reached
+// without passing it) or slows to the velocity limit (the move began faster), and ends with a double s move to the
+// target. this is not time optimal, but every step is closed form or a bisection of fixed length and the segments live
+// in the object, so planning never allocates and its worst case is bounded.
+template <typename Scalar = float>
+class BasicSigmoidReplanProfile {
+public:
+	struct SigmoidMotionState {
+		Scalar distance;
+		Scalar velocity;
+		Scalar acceleration;
+	};
+
+	constexpr                                          BasicSigmoidReplanProfile (const SigmoidMotionState& state_begin, Scalar distance_target, Scalar velocity_max, Scalar acceleration_max, Scalar jerk) noexcept;
+	constexpr Scalar                                   get_time_distance         (Scalar progress_time) const noexcept;
+	constexpr Scalar                                   get_time_velocity         (Scalar progress_time) const noexcept;
+	constexpr Scalar                                   get_time_acceleration     (Scalar progress_time) const noexcept;
+	constexpr Scalar                                   get_time_jerk             (Scalar progress_time) const noexcept;
+	constexpr SigmoidMotionState                       get_time_state            (Scalar progress_time) const noexcept; // state to replan from
+	constexpr Scalar                                   get_time_end              () const noexcept;
+	constexpr int                                      get_segment_count         () const noexcept;
+	constexpr const BasicMotionProfileSegment<Scalar>* get_segments              () const noexcept;
+private:
+	BasicMotionProfileSegment<Scalar> segments[SIGMOID_REPLAN_SEGMENT_COUNT_MAX] = {}; // in time since the replan and absolute distance
+	int                               segment_count = 0;
+	Scalar                            time_end      = 0;
+	Scalar                            distance_end  = 0;
+
+	constexpr void   replan_append     (typename BasicSigmoidMotionProfile<Scalar>::SigmoidPhaseAnchors (&phase_anchors)[7], Scalar jerk, Scalar velocity_begin, Scalar direction) noexcept;
+	constexpr int    replan_index      (Scalar progress_time) const noexcept;
+	constexpr Scalar replan_time_clamp (Scalar progress_time) const noexcept;
+};
+
+using SigmoidReplanProfile = BasicSigmoidReplanProfile<float>;
+
+template <typename Scalar>
+constexpr Scalar sigmoid_phase_anchors_ramp(Scalar velocity_from, Scalar velocity_to, Scalar acceleration_max, Scalar jerk, typename BasicSigmoidMotionProfile<Scalar>::SigmoidPhaseAnchors (&phase_anchors)[7]) noexcept;
+
+template <typename Scalar>
+constexpr BasicSigmoidReplanProfile<Scalar>::BasicSigmoidReplanProfile(const SigmoidMotionState& state_begin, Scalar distance_target, Scalar velocity_max, Scalar acceleration_max, Scalar jerk) noexcept {
+	this->distance_end = state_begin.distance;
+	Scalar velocity    = state_begin.velocity;
+	// release the acceleration (every later piece begins and ends without one)
+	Scalar time_release = (state_begin.acceleration < 0 ? (-1) * state_begin.acceleration : state_begin.acceleration) / jerk;
+	if (time_release > 0) {
+		Scalar jerk_release = (state_begin.acceleration > 0 ? (-1) * jerk : jerk);
+		this->segments[this->segment_count++] = {0, jerk_release / 6, state_begin.acceleration / 2, velocity, this->distance_end};
+		this->distance_end += ((jerk_release / 6 * time_release + state_begin.acceleration / 2) * time_release + velocity) * time_release;
+		velocity           += state_begin.acceleration * time_release / 2;
+		this->time_end      = time_release;
+	}
+	// the rest is planned in the frame of the current motion (or of the target when at rest), speeds are positive
+	Scalar distance_left = distance_target - this->distance_end;
+	Scalar direction     = (velocity != 0 ? (velocity > 0 ? Scalar(1) : Scalar(-1)) : (distance_left < 0 ? Scalar(-1) : Scalar(1)));
+	Scalar speed         = direction * velocity;
+	typename BasicSigmoidMotionProfile<Scalar>::SigmoidPhaseAnchors phase_anchors[7] = {};
+	Scalar distance_stop = speed * sigmoid_phase_anchors_ramp(speed, Scalar(0), acceleration_max, jerk, phase_anchors) / 2;
+	if (direction * distance_left < distance_stop) {
+		// the target is behind or closer than the stop: stop, then head for it from rest
+		this->replan_append(phase_anchors, jerk, speed, direction);
+		distance_left = distance_target - this->distance_end;
+		direction     = (distance_left < 0 ? Scalar(-1) : Scalar(1));
+		speed         = 0;
+	} else if (speed > velocity_max) {
+		// slow to the limit when the stop still fits behind that, otherwise cruise at the current speed until the stop
+		Scalar distance_slow = (speed + velocity_max) * sigmoid_phase_anchors_ramp(speed, velocity_max, acceleration_max, jerk, phase_anchors) / 2;
+		typename BasicSigmoidMotionProfile<Scalar>::SigmoidPhaseAnchors phase_anchors_stop[7] = {};
+		Scalar distance_stop_limit = velocity_max * sigmoid_phase_anchors_ramp(velocity_max, Scalar(0), acceleration_max, jerk, phase_anchors_stop) / 2;
+		if (direction * distance_left >= distance_slow + distance_stop_limit) {
+			this->replan_append(phase_anchors, jerk, speed, direction);
+			distance_left = distance_target - this->distance_end;
+			speed         = velocity_max;
+		}
+	}
+	if (direction * distance_left > 0) {
+		sigmoid_phase_anchors_boundary(direction * distance_left, speed, Scalar(0), std::max(velocity_max, speed), acceleration_max, jerk, phase_anchors);
+		this->replan_append(phase_anchors, jerk, speed, direction);
+	}
+	// already resting at the target
+	if (this->segment_count == 0) this->segments[this->segment_count++] = {0, 0, 0, 0, this->distance_end};
+}
+
+template <typename Scalar>
+constexpr Scalar BasicSigmoidReplanProfile<Scalar>::get_time_distance(Scalar progress_time) const noexcept {
+	progress_time = this->replan_time_clamp(progress_time);
+	const BasicMotionProfileSegment<Scalar>& segment = this->segments[this->replan_index(progress_time)];
+	return motion_profile_segment_distance(segment, progress_time - segment.time_begin);
+}
+
+template <typename Scalar>
+constexpr Scalar BasicSigmoidReplanProfile<Scalar>::get_time_velocity(Scalar progress_time) const noexcept {
+	progress_time = this->replan_time_clamp(progress_time);
+	const BasicMotionProfileSegment<Scalar>& segment = this->segments[this->replan_index(progress_time)];
+	return motion_profile_segment_velocity(segment, progress_time - segment.time_begin);
+}
+
+template <typename Scalar>
+constexpr Scalar BasicSigmoidReplanProfile<Scalar>::get_time_acceleration(Scalar progress_time) const noexcept {
+	progress_time = this->replan_time_clamp(progress_time);
+	const BasicMotionProfileSegment<Scalar>& segment = this->segments[this->replan_index(progress_time)];
+	return motion_profile_segment_acceleration(segment, progress_time - segment.time_begin);
+}
+
+template <typename Scalar>
+constexpr Scalar BasicSigmoidReplanProfile<Scalar>::get_time_jerk(Scalar progress_time) const noexcept {
+	if (!(progress_time >= 0) || progress_time >= this->time_end) return 0;
+	return motion_profile_segment_jerk(this->segments[this->replan_index(progress_time)]);
+}
+
+template <typename Scalar>
+constexpr typename BasicSigmoidReplanProfile<Scalar>::SigmoidMotionState BasicSigmoidReplanProfile<Scalar>::get_time_state(Scalar progress_time) const noexcept {
+	return {this->get_time_distance(progress_time), this->get_time_velocity(progress_time), this->get_time_acceleration(progress_time)};
+}
+
+template <typename Scalar>
+constexpr Scalar BasicSigmoidReplanProfile<Scalar>::get_time_end() const noexcept {
+	return this->time_end;
+}
+
+template <typename Scalar>
+constexpr int BasicSigmoidReplanProfile<Scalar>::get_segment_count() const noexcept {
+	return this->segment_count;
+}
+
+template <typename Scalar>
+constexpr const BasicMotionProfileSegment<Scalar>* BasicSigmoidReplanProfile<Scalar>::get_segments() const noexcept {
+	return this->segments;
+}
+
+template <typename Scalar>
+constexpr void BasicSigmoidReplanProfile<Scalar>::replan_append(typename BasicSigmoidMotionProfile<Scalar>::SigmoidPhaseAnchors (&phase_anchors)[7], Scalar jerk, Scalar velocity_begin, Scalar direction) noexcept {
+	// phases with duration are mirrored into the frame of the path and appended after the current end
+	BasicMotionProfileSegment<Scalar> phase_segments[7] = {};
+	sigmoid_phase_integrate(jerk, velocity_begin, phase_anchors, phase_segments);
+	for (int phase_index = 0; phase_index < 7; phase_index++) {
+		if (!(phase_anchors[phase_index].time_phase_section > 0)) continue;
+		const BasicMotionProfileSegment<Scalar>& phase_segment = phase_segments[phase_index];
+		this->segments[this->segment_count++] = {
+			this->time_end + phase_segment.time_begin,
+			direction * phase_segment.cubic_degree_third,
+			direction * phase_segment.cubic_degree_second,
+			direction * phase_segment.cubic_degree_first,
+			this->distance_end + direction * phase_segment.cubic_degree_zero
+		};
+	}
+	this->time_end     += phase_anchors[6].time_phase_end;
+	this->distance_end += direction * phase_anchors[6].distance_phase_end;
+}
+
+template <typename Scalar>
+constexpr int BasicSigmoidReplanProfile<Scalar>::replan_index(Scalar progress_time) const noexcept {
+	return motion_profile_segment_search(this->segments, this->segment_count, progress_time);
+}
+
+template <typename Scalar>
+constexpr Scalar BasicSigmoidReplanProfile<Scalar>::replan_time_clamp(Scalar progress_time) const noexcept {
+	return std::min(std::max(progress_time, Scalar(0)), this->time_end);
+}
+
+template <typename Scalar>
+constexpr Scalar sigmoid_phase_anchors_ramp(Scalar velocity_from, Scalar velocity_to, Scalar acceleration_max, Scalar jerk, typename BasicSigmoidMotionProfile<Scalar>::SigmoidPhaseAnchors (&phase_anchors)[7]) noexcept {
+	// change of velocity between two rests of the acceleration, as the accelerate (or decelerate) phases of a sigmoid
+	// move with every other phase empty. returns its duration
+	bool   ramp_up         = velocity_to > velocity_from;
+	Scalar velocity_change = (ramp_up ? velocity_to - velocity_from : velocity_from - velocity_to);
+	Scalar time_jerk       = 0;
+	Scalar time_retain     = 0;
+	if (velocity_change * jerk < acceleration_max * acceleration_max) {
+		time_jerk = motion_profile_sqrt(velocity_change / jerk);
+	} else {
+		time_jerk   = acceleration_max / jerk;
+		time_retain = velocity_change / acceleration_max - time_jerk;
+	}
+	Scalar phases_time_full[7] = {};
+	int    phase_first         = (ramp_up ? (int) BasicSigmoidMotionProfile<Scalar>::SigmoidPhase::ACCELERATE_BEGIN : (int) BasicSigmoidMotionProfile<Scalar>::SigmoidPhase::DECELERATE_BEGIN);
+	phases_time_full[phase_first]     = time_jerk;
+	phases_time_full[phase_first + 1] = time_retain;
+	phases_time_full[phase_first + 2] = time_jerk;
+	Scalar time_phase_accumulate = 0;
+	for (int phase_index = 0; phase_index < 7; phase_index++) {
+		phase_anchors[phase_index] = {time_phase_accumulate, phases_time_full[phase_index], time_phase_accumulate + phases_time_full[phase_index], 0, 0, 0};
+		time_phase_accumulate     += phases_time_full[phase_index];
+	}
+	return time_phase_accumulate;
+}
\ No newline at end of file
@@ -0,0 +1,121 @@
+#include <cmath>
+#include <cfloat>
+#include <chrono>
+#include <algorithm>
+#include "motion_profile_sigmoid_table.h"
+
+#define SIGMOID_TABLE_CHECK_POINTS 16   // points compared against the exact path in every segment
+#define SIGMOID_TABLE_DEPTH_MAX    20   // segments stop splitting at 2^-20 of their phase, whatever the error
+#define SIGMOID_TABLE_WIDTH_ULPS   1024 // or once they span fewer float steps of distance than this (the exact path is no better below)
+
+SigmoidDistanceTable::SigmoidDistanceTable(const SigmoidMotionProfile& motion_profile, float error_max) {
+	std::chrono::steady_clock::time_point time_build_begin = std::chrono::steady_clock::now();
+	this->jerk                 = motion_profile.get_time_jerk(0.0f);
+	this->distance_table_begin = motion_profile.get_anchors(SigmoidMotionProfile::SigmoidPhase::ACCELERATE_BEGIN).distance_phase_end;
+	this->distance_table_end   = motion_profile.get_anchors(SigmoidMotionProfile::SigmoidPhase::DECELERATE_END).distance_phase_begin;
+	this->distance_total       = motion_profile.get_anchors(SigmoidMotionProfile::SigmoidPhase::DECELERATE_END).distance_phase_end;
+	this->report               = {0, 0, 0.0, 0.0f, 0.0f};
+	// chebyshev nodes of a cubic on [-1, 1]
+	double chebyshev_nodes[4];
+	for (int node_index = 0; node_index < 4; node_index++) chebyshev_nodes[node_index] = std::cos((2 * node_index + 1) * 3.14159265358979323846 / 8);
+	// cover every phase between the end phases on its own (the polynomials are only smooth within a phase)
+	for (int phase_index = (int) SigmoidMotionProfile::SigmoidPhase::ACCELERATE_RETAIN; phase_index <= (int) SigmoidMotionProfile::SigmoidPhase::DECELERATE_RETAIN; phase_index++) {
+		SigmoidMotionProfile::SigmoidPhaseAnchors phase_anchor = motion_profile.get_anchors((SigmoidMotionProfile::SigmoidPhase) phase_index);
+		if (!(phase_anchor.distance_phase_section > 0.0f)) continue;
+		// depth-first splitting, the right half is pushed first so segments come out in distance order
+		struct SegmentPending {
+			double distance_begin;
+			double distance_end;
+			int    segment_depth;
+		};
+		std::vector<SegmentPending> segments_pending = {{phase_anchor.distance_phase_begin, phase_anchor.distance_phase_end, 0}};
+		while (!segments_pending.empty()) {
+			SegmentPending segment_pending = segments_pending.back();
+			segments_pending.pop_back();
+			double distance_middle = 0.5 * (segment_pending.distance_begin + segment_pending.distance_end);
+			double distance_half   = 0.5 * (segment_pending.distance_end - segment_pending.distance_begin);
+			// interpolate at the nodes (chebyshev series, then monomial form for horner)
+			double chebyshev_velocity[4]     = {0.0, 0.0, 0.0, 0.0};
+			double chebyshev_acceleration[4] = {0.0, 0.0, 0.0, 0.0};
+			for (int node_index = 0; node_index < 4; node_index++) {
+				double node                 = chebyshev_nodes[node_index];
+				float  node_distance        = (float) (distance_middle + node * distance_half);
+				double node_velocity        = motion_profile.get_distance_velocity(node_distance);
+				double node_acceleration    = motion_profile.get_distance_acceleration(node_distance);
+				double node_chebyshev[4]    = {1.0, node, 2 * node * node - 1, 4 * node * node * node - 3 * node};
+				for (int degree = 0; degree < 4; degree++) {
+					chebyshev_velocity[degree]     += (degree == 0 ? 0.25 : 0.5) * node_velocity * node_chebyshev[degree];
+					chebyshev_acceleration[degree] += (degree == 0 ? 0.25 : 0.5) * node_acceleration * node_chebyshev[degree];
+				}
+			}
+			SigmoidDistanceSegment segment = {
+				(float) distance_middle,
+				(float) (1.0 / distance_half),
+				{(float) (chebyshev_velocity[0] - chebyshev_velocity[2]), (float) (chebyshev_velocity[1] - 3 * chebyshev_velocity[3]), (float) (2 * chebyshev_velocity[2]), (float) (4 * chebyshev_velocity[3])},
+				{(float) (chebyshev_acceleration[0] - chebyshev_acceleration[2]), (float) (chebyshev_acceleration[1] - 3 * chebyshev_acceleration[3]), (float) (2 * chebyshev_acceleration[2]), (float) (4 * chebyshev_acceleration[3])}
+			};
+			// compare against the exact path (end points included)
+			float error_velocity     = 0.0f;
+			float error_acceleration = 0.0f;
+			for (int check_index = 0; check_index <= SIGMOID_TABLE_CHECK_POINTS; check_index++) {
+				float check_mapped       = -1.0f + 2.0f * check_index / SIGMOID_TABLE_CHECK_POINTS;
+				float check_distance     = (float) (distance_middle + check_mapped * distance_half);
+				float check_velocity     = ((segment.velocity_cubic[3] * check_mapped + segment.velocity_cubic[2]) * check_mapped + segment.velocity_cubic[1]) * check_mapped + segment.velocity_cubic[0];
+				float check_acceleration = ((segment.acceleration_cubic[3] * check_mapped + segment.acceleration_cubic[2]) * check_mapped + segment.acceleration_cubic[1]) * check_mapped + segment.acceleration_cubic[0];
+				error_velocity     = std::max(error_velocity,     std::fabs(check_velocity     - motion_profile.get_distance_velocity(check_distance)));
+				error_acceleration = std::max(error_acceleration, std::fabs(check_acceleration - motion_profile.get_distance_acceleration(check_distance)));
+			}
+			bool segment_splittable = segment_pending.segment_depth < SIGMOID_TABLE_DEPTH_MAX && 2 * distance_half > SIGMOID_TABLE_WIDTH_ULPS * FLT_EPSILON * std::fabs(segment_pending.distance_end);
+			if ((error_velocity > error_max || error_acceleration > error_max) && segment_splittable) {
+				segments_pending.push_back({distance_middle,                segment_pending.distance_end, segment_pending.segment_depth + 1});
+				segments_pending.push_back({segment_pending.distance_begin, distance_middle,              segment_pending.segment_depth + 1});
+				continue;
+			}
+			this->segment_distance_begin.push_back((float) segment_pending.distance_begin);
+			this->segments.push_back(segment);
+			this->report.error_velocity_max     = std::max(this->report.error_velocity_max,     error_velocity);
+			this->report.error_acceleration_max = std::max(this->report.error_acceleration_max, error_acceleration);
+		}
+	}
+	this->segment_distance_begin.shrink_to_fit();
+	this->segments.shrink_to_fit();
+	this->report.segment_count = (int) this->segments.size();
+	this->report.memory_bytes  = this->segments.capacity() * sizeof(SigmoidDistanceSegment) + this->segment_distance_begin.capacity() * sizeof(float);
+	this->report.build_seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - time_build_begin).count();
+}
+
+float SigmoidDistanceTable::get_distance_velocity(float progress_distance) const {
+	// end phases in closed form: distance = jerk * time^3 / 6 measured from the nearer end of the motion
+	if (progress_distance <= this->distance_table_begin || this->segments.empty()) {
+		float time_section = std::cbrt(6 * std::fmax(progress_distance, 0.0f) / this->jerk);
+		return (1 / 2.0f) * this->jerk * time_section * time_section;
+	}
+	if (progress_distance >= this->distance_table_end) {
+		float time_section = std::cbrt(6 * std::fmax(this->distance_total - progress_distance, 0.0f) / this->jerk);
+		return (1 / 2.0f) * this->jerk * time_section * time_section;
+	}
+	const SigmoidDistanceSegment& segment = this->segments[this->segment_index(progress_distance)];
+	float distance_mapped = (progress_distance - segment.distance_middle) * segment.distance_scale;
+	return ((segment.velocity_cubic[3] * distance_mapped + segment.velocity_cubic[2]) * distance_mapped + segment.velocity_cubic[1]) * distance_mapped + segment.velocity_cubic[0];
+}
+
+float SigmoidDistanceTable::get_distance_acceleration(float progress_distance) const {
+	if (progress_distance <= this->distance_table_begin || this->segments.empty()) {
+		return this->jerk * std::cbrt(6 * std::fmax(progress_distance, 0.0f) / this->jerk);
+	}
+	if (progress_distance >= this->distance_table_end) {
+		return (-1) * this->jerk * std::cbrt(6 * std::fmax(this->distance_total - progress_distance, 0.0f) / this->jerk);
+	}
+	const SigmoidDistanceSegment& segment = this->segments[this->segment_index(progress_distance)];
+	float distance_mapped = (progress_distance - segment.distance_middle) * segment.distance_scale;
+	return ((segment.acceleration_cubic[3] * distance_mapped + segment.acceleration_cubic[2]) * distance_mapped + segment.acceleration_cubic[1]) * distance_mapped + segment.acceleration_cubic[0];
+}
+
+SigmoidDistanceTable::SigmoidDistanceTableReport SigmoidDistanceTable::get_report() const {
+	return this->report;
+}
+
+int SigmoidDistanceTable::segment_index(float progress_distance) const {
+	std::vector<float>::const_iterator segment_after = std::upper_bound(this->segment_distance_begin.begin(), this->segment_distance_begin.end(), progress_distance);
+	return std::max((int) (segment_after - this->segment_distance_begin.begin()) - 1, 0);
+}
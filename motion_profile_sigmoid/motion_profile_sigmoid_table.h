@@ -0,0 +1,40 @@
+#pragma once
+#include <vector>
+#include "motion_profile_sigmoid.h"
+
+// compiled distance-indexed view of a sigmoid profile: velocity and acceleration by distance without solving for time.
+// the rest-to-rest end phases are inverted in closed form, the phases between are covered by cubic segments
+// (interpolated at chebyshev nodes) that are split until they meet the requested error. an error below what the float
+// exact path itself resolves cannot be met, the report holds the error that was reached.
+class SigmoidDistanceTable {
+public:
+	struct SigmoidDistanceSegment {
+		float distance_middle;         // distance the segment is centered on
+		float distance_scale;          // maps the segment onto [-1, 1]
+		float velocity_cubic[4];       // velocity polynomial in the mapped distance (degree zero first)
+		float acceleration_cubic[4];   // acceleration polynomial in the mapped distance (degree zero first)
+	};
+
+	struct SigmoidDistanceTableReport {
+		int    segment_count;          // number of cubic segments
+		size_t memory_bytes;           // heap used by the segment table
+		double build_seconds;          // time spent building the table
+		float  error_velocity_max;     // worst velocity deviation from the exact path seen while checking segments
+		float  error_acceleration_max; // worst acceleration deviation from the exact path seen while checking segments
+	};
+
+	SigmoidDistanceTable                                 (const SigmoidMotionProfile& motion_profile, float error_max);
+	float                      get_distance_velocity     (float progress_distance) const;
+	float                      get_distance_acceleration (float progress_distance) const;
+	SigmoidDistanceTableReport get_report                () const;
+private:
+	float                               jerk;
+	float                               distance_total;
+	float                               distance_table_begin; // distance the accelerate-begin phase ends
+	float                               distance_table_end;   // distance the decelerate-end phase begins
+	std::vector<float>                  segment_distance_begin;
+	std::vector<SigmoidDistanceSegment> segments;
+	SigmoidDistanceTableReport          report;
+
+	int segment_index(float progress_distance) const;
+};
@@ -0,0 +1,49 @@
+#include <algorithm>
+#include "motion_profile_stream.h"
+
+MotionProfileSetpointRing::MotionProfileSetpointRing(size_t capacity) {
+	size_t slot_count = 2;
+	while (slot_count < capacity) slot_count *= 2;
+	this->slots.resize(slot_count);
+	this->slot_mask = slot_count - 1;
+}
+
+size_t MotionProfileSetpointRing::get_size() const noexcept {
+	size_t index_pop  = this->index_pop.load(std::memory_order_acquire);
+	size_t index_push = this->index_push.load(std::memory_order_acquire);
+	return std::min(index_push - index_pop, this->get_capacity());
+}
+
+MotionProfileSetpointRing::StreamCounters MotionProfileSetpointRing::get_counters() const noexcept {
+	StreamCounters stream_counters;
+	stream_counters.push_count         = this->counter_push.load(std::memory_order_relaxed);
+	stream_counters.push_refused_count = this->counter_push_refused.load(std::memory_order_relaxed);
+	stream_counters.pop_count          = this->counter_pop.load(std::memory_order_relaxed);
+	stream_counters.underrun_count     = this->counter_underrun.load(std::memory_order_relaxed);
+	stream_counters.occupancy_max      = this->counter_occupancy_max.load(std::memory_order_relaxed);
+	return stream_counters;
+}
+
+size_t MotionProfileSetpointRing::get_push_available() const noexcept {
+	return this->get_capacity() - (this->index_push.load(std::memory_order_relaxed) - this->index_pop.load(std::memory_order_acquire));
+}
+
+void MotionProfileSetpointRing::finish() noexcept {
+	this->producer_finished.store(true, std::memory_order_release);
+}
+
+void MotionProfileSetpointRing::restart() noexcept {
+	this->producer_finished.store(false, std::memory_order_release);
+}
+
+size_t motion_profile_stream_feed(MotionProfileSetpointRing& setpoint_ring, MotionProfileCursor& cursor, float time_offset, float position_offset) noexcept {
+	// only as many as fit, so a full ring is not counted as refused pushes over and over
+	size_t push_count = 0;
+	size_t push_limit = setpoint_ring.get_push_available();
+	for (; push_count < push_limit && !cursor.is_done(); push_count++) {
+		const MotionProfileSample& sample = cursor.get_sample();
+		setpoint_ring.push({time_offset + sample.time, position_offset + sample.distance, sample.velocity, sample.acceleration});
+		cursor.advance();
+	}
+	return push_count;
+}
\ No newline at end of file
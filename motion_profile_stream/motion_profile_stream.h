@@ -0,0 +1,110 @@
+#pragma once
+#include <atomic>
+#include <vector>
+#include <cstddef>
+#include "../motion_profile_cursor/motion_profile_cursor.h"
+
+#define MOTION_PROFILE_STREAM_CAPACITY_DEFAULT 1024 // setpoints buffered ahead (rounded up to a power of two)
+#define MOTION_PROFILE_STREAM_LINE             64   // the producer and consumer sides live on separate cache lines
+
+struct MotionProfileSetpoint {
+	float time;
+	float position;
+	float velocity;
+	float acceleration;
+};
+
+enum class MotionProfileStreamStatus {
+	SETPOINT, // a setpoint was popped
+	UNDERRUN, // nothing buffered although the producer has not finished (counted)
+	FINISHED  // nothing buffered and the producer finished
+};
+
+// single producer, single consumer ring of setpoints between a planner and a control thread. the slots are allocated
+// once by the constructor, afterwards push and pop never allocate, lock or loop: each is a bounded handful of loads and
+// stores (wait-free). a full ring refuses the push (back-pressure, the producer retries later), an empty one reports an
+// underrun unless the producer finished. the producer side (push, finish, feed) belongs to one thread, the consumer
+// side (pop) to another, the counters may be read from any thread
+class MotionProfileSetpointRing {
+public:
+	struct StreamCounters {
+		unsigned long long push_count;
+		unsigned long long push_refused_count; // pushes refused while full
+		unsigned long long pop_count;
+		unsigned long long underrun_count;     // pops that found nothing while the producer had not finished
+		size_t             occupancy_max;      // most setpoints buffered after a push, as far as the producer knew
+	};
+
+	MotionProfileSetpointRing                           (size_t capacity = MOTION_PROFILE_STREAM_CAPACITY_DEFAULT);
+	MotionProfileSetpointRing                           (const MotionProfileSetpointRing&) = delete;
+	MotionProfileSetpointRing&       operator=          (const MotionProfileSetpointRing&) = delete;
+	size_t                           get_capacity       () const noexcept { return this->slot_mask + 1; }
+	size_t                           get_size           () const noexcept; // approximate while either side runs
+	StreamCounters                   get_counters       () const noexcept;
+	// producer
+	inline bool                      push               (const MotionProfileSetpoint& setpoint) noexcept;
+	size_t                           get_push_available () const noexcept;
+	void                             finish             () noexcept; // no more setpoints follow, drained pops report FINISHED
+	void                             restart            () noexcept; // a new stream follows (call once the consumer drained)
+	// consumer
+	inline MotionProfileStreamStatus pop                (MotionProfileSetpoint& setpoint) noexcept;
+private:
+	std::vector<MotionProfileSetpoint> slots;
+	size_t                             slot_mask;
+	// producer line: the index it writes next, its last look at the consumer index and its counters
+	alignas(MOTION_PROFILE_STREAM_LINE)
+	std::atomic<size_t>                index_push            = 0;
+	size_t                             index_pop_cached      = 0;
+	std::atomic<unsigned long long>    counter_push          = 0;
+	std::atomic<unsigned long long>    counter_push_refused  = 0;
+	std::atomic<size_t>                counter_occupancy_max = 0;
+	std::atomic<bool>                  producer_finished     = false;
+	// consumer line (the ring is a whole number of lines, nothing after it shares this one)
+	alignas(MOTION_PROFILE_STREAM_LINE)
+	std::atomic<size_t>                index_pop             = 0;
+	size_t                             index_push_cached     = 0;
+	std::atomic<unsigned long long>    counter_pop           = 0;
+	std::atomic<unsigned long long>    counter_underrun      = 0;
+};
+
+// pushes the samples of a cursor until it is done or the ring is full and returns how many were pushed. the cursor keeps
+// its place, so calling again once the consumer made room resumes the move. time and position are offset (to chain
+// moves into one stream)
+size_t motion_profile_stream_feed(MotionProfileSetpointRing& setpoint_ring, MotionProfileCursor& cursor, float time_offset = 0.0f, float position_offset = 0.0f) noexcept;
+
+// the counters are only written by the side owning them (load then store, no read-modify-write on the hot path)
+inline bool MotionProfileSetpointRing::push(const MotionProfileSetpoint& setpoint) noexcept {
+	size_t index_push = this->index_push.load(std::memory_order_relaxed);
+	if (index_push - this->index_pop_cached > this->slot_mask) {
+		// looks full, look again at where the consumer is
+		this->index_pop_cached = this->index_pop.load(std::memory_order_acquire);
+		if (index_push - this->index_pop_cached > this->slot_mask) {
+			this->counter_push_refused.store(this->counter_push_refused.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+			return false;
+		}
+	}
+	this->slots[index_push & this->slot_mask] = setpoint;
+	this->index_push.store(index_push + 1, std::memory_order_release);
+	this->counter_push.store(this->counter_push.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+	size_t occupancy = index_push + 1 - this->index_pop_cached;
+	if (occupancy > this->counter_occupancy_max.load(std::memory_order_relaxed)) this->counter_occupancy_max.store(occupancy, std::memory_order_relaxed);
+	return true;
+}
+
+inline MotionProfileStreamStatus MotionProfileSetpointRing::pop(MotionProfileSetpoint& setpoint) noexcept {
+	size_t index_pop = this->index_pop.load(std::memory_order_relaxed);
+	if (index_pop == this->index_push_cached) {
+		// looks empty, look again at where the producer is (finished first, so a setpoint pushed before finishing is seen)
+		bool finished           = this->producer_finished.load(std::memory_order_acquire);
+		this->index_push_cached = this->index_push.load(std::memory_order_acquire);
+		if (index_pop == this->index_push_cached) {
+			if (finished) return MotionProfileStreamStatus::FINISHED;
+			this->counter_underrun.store(this->counter_underrun.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+			return MotionProfileStreamStatus::UNDERRUN;
+		}
+	}
+	setpoint = this->slots[index_pop & this->slot_mask];
+	this->index_pop.store(index_pop + 1, std::memory_order_release);
+	this->counter_pop.store(this->counter_pop.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+	return MotionProfileStreamStatus::SETPOINT;
+}
\ No newline at end of file
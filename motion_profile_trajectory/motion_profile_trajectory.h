@@ -0,0 +1,278 @@
+#pragma once
+#include <vector>
+#include <algorithm>
+#include "../motion_profile_segment/motion_profile_segment.h"
+#include "../motion_profile_sigmoid/motion_profile_sigmoid.h"
+
+#define MOTION_PROFILE_TRAJECTORY_REACH_ITERATIONS 32 // newton steps for the velocity a short jerk limited ramp reaches
+#define MOTION_PROFILE_TRAJECTORY_LOOKAHEAD        32 // legs an append may replan (earlier junctions keep their lower limits)
+
+// path through a chain of waypoints that only stops at its end. every leg between two waypoints is a 7 phase sigmoid
+// move (or a trapezoidal one) between the velocities planned for its waypoints, and all legs are flattened into one
+// table of segments in absolute time and distance, looked up by binary search. waypoints are appended while the path
+// runs: the lookahead replans the legs that are not sealed yet, so the path always ends at rest at its last waypoint.
+template <typename Scalar = float>
+class BasicMotionProfileTrajectory {
+public:
+	struct TrajectoryWaypoint {
+		Scalar distance;         // path distance of the waypoint (ascending)
+		Scalar velocity_pass;    // velocity allowed when passing the waypoint (the last one is always passed at rest)
+		Scalar velocity_max;     // limits of the leg that leads to the waypoint
+		Scalar acceleration_max;
+		Scalar jerk;             // zero plans the leg trapezoidal
+	};
+
+	BasicMotionProfileTrajectory                                         (Scalar distance_begin = 0);
+	void                                     append_waypoint             (const TrajectoryWaypoint& waypoint); // replans the unsealed legs
+	void                                     seal                        (Scalar progress_time);                // legs begun by this time are never replanned again
+	int                                      get_leg_count               () const;
+	int                                      get_segment_count           () const;
+	const BasicMotionProfileSegment<Scalar>* get_segments                () const; // valid until the next append
+	Scalar                                   get_waypoint_velocity       (int waypoint_index) const; // planned velocity at a waypoint (0 is the start)
+	Scalar                                   get_time_end                () const;
+	Scalar                                   get_time_distance           (Scalar progress_time) const;
+	Scalar                                   get_time_velocity           (Scalar progress_time) const;
+	Scalar                                   get_time_acceleration       (Scalar progress_time) const;
+	Scalar                                   get_time_jerk               (Scalar progress_time) const;
+	Scalar                                   get_distance_time           (Scalar progress_distance) const;
+	Scalar                                   get_distance_velocity       (Scalar progress_distance) const;
+	Scalar                                   get_distance_acceleration   (Scalar progress_distance) const;
+private:
+	struct TrajectoryLeg {
+		TrajectoryWaypoint waypoint_end;      // waypoint the leg leads to (with its limits)
+		Scalar             distance_begin;
+		Scalar             time_begin;
+		int                segment_begin;     // first segment of the leg in the flat table
+	};
+
+	struct TrajectoryJunction {
+		Scalar velocity_pass;     // velocity limit at the waypoint (pass limit and both adjacent leg limits)
+		Scalar velocity_backward; // fastest velocity from which the rest of the path can still stop at its end
+		Scalar velocity;          // planned velocity
+	};
+
+	std::vector<BasicMotionProfileSegment<Scalar>> segments;  // all legs in absolute time and distance
+	std::vector<TrajectoryLeg>                     legs;
+	std::vector<TrajectoryJunction>                junctions; // one per waypoint, the start included
+	Scalar                                         distance_begin;
+	Scalar                                         time_end   = 0;
+	int                                            leg_sealed = 0; // legs before this index are never replanned
+
+	int    trajectory_segment_index          (Scalar progress_time) const;
+	int    trajectory_segment_index_distance (Scalar progress_distance) const;
+	Scalar trajectory_time_clamp             (Scalar progress_time) const;
+	void   trajectory_leg_plan               (int leg_index);
+};
+
+using MotionProfileTrajectory = BasicMotionProfileTrajectory<float>;
+
+template <typename Scalar>
+Scalar motion_profile_trajectory_velocity_reach(Scalar velocity_from, Scalar distance, Scalar acceleration_max, Scalar jerk);
+
+template <typename Scalar>
+BasicMotionProfileTrajectory<Scalar>::BasicMotionProfileTrajectory(Scalar distance_begin) {
+	this->distance_begin = distance_begin;
+	this->junctions.push_back({0, 0, 0});
+}
+
+template <typename Scalar>
+void BasicMotionProfileTrajectory<Scalar>::append_waypoint(const TrajectoryWaypoint& waypoint) {
+	// waypoints that do not advance the path are dropped
+	Scalar distance_last = (this->legs.empty() ? this->distance_begin : this->legs.back().waypoint_end.distance);
+	if (!(waypoint.distance > distance_last)) return;
+	this->legs.push_back({waypoint, distance_last, this->time_end, (int) this->segments.size()});
+	// the former end may now be passed at speed, limited by both legs it joins (unless it began a sealed leg)
+	int junction_last = (int) this->junctions.size() - 1;
+	if (junction_last > 0) {
+		const TrajectoryWaypoint& waypoint_last = this->legs[junction_last - 1].waypoint_end;
+		this->junctions[junction_last].velocity_pass = std::min(waypoint_last.velocity_pass, std::min(waypoint_last.velocity_max, waypoint.velocity_max));
+	}
+	this->junctions.push_back({0, 0, 0});
+	// backward pass: raise the stop limits from the new end, until a junction keeps its limit (the earlier ones do too)
+	int junction_first = std::max(this->leg_sealed + 1, (int) this->junctions.size() - 1 - MOTION_PROFILE_TRAJECTORY_LOOKAHEAD); // earliest junction whose velocity may still change
+	int junction_index = (int) this->junctions.size() - 2;
+	for (; junction_index >= junction_first; junction_index--) {
+		const TrajectoryWaypoint& waypoint_next     = this->legs[junction_index].waypoint_end;
+		Scalar                    distance_section  = waypoint_next.distance - this->legs[junction_index].distance_begin;
+		Scalar                    velocity_backward = std::min(this->junctions[junction_index].velocity_pass, motion_profile_trajectory_velocity_reach(this->junctions[junction_index + 1].velocity_backward, distance_section, waypoint_next.acceleration_max, waypoint_next.jerk));
+		if (velocity_backward == this->junctions[junction_index].velocity_backward && junction_index < (int) this->junctions.size() - 2) break;
+		this->junctions[junction_index].velocity_backward = velocity_backward;
+	}
+	// forward pass from the earliest junction that changed, then replan every leg from the one ending there
+	int leg_first = std::max(junction_index, this->leg_sealed);
+	for (int leg_index = leg_first; leg_index < (int) this->legs.size(); leg_index++) {
+		const TrajectoryWaypoint& waypoint_next    = this->legs[leg_index].waypoint_end;
+		Scalar                    distance_section = waypoint_next.distance - this->legs[leg_index].distance_begin;
+		Scalar                    velocity_forward = motion_profile_trajectory_velocity_reach(this->junctions[leg_index].velocity, distance_section, waypoint_next.acceleration_max, waypoint_next.jerk);
+		this->junctions[leg_index + 1].velocity    = std::min(this->junctions[leg_index + 1].velocity_backward, velocity_forward);
+	}
+	this->segments.resize(this->legs[leg_first].segment_begin);
+	this->time_end = this->legs[leg_first].time_begin;
+	for (int leg_index = leg_first; leg_index < (int) this->legs.size(); leg_index++) this->trajectory_leg_plan(leg_index);
+}
+
+template <typename Scalar>
+void BasicMotionProfileTrajectory<Scalar>::seal(Scalar progress_time) {
+	while (this->leg_sealed < (int) this->legs.size() && this->legs[this->leg_sealed].time_begin <= progress_time) this->leg_sealed++;
+}
+
+template <typename Scalar>
+int BasicMotionProfileTrajectory<Scalar>::get_leg_count() const {
+	return (int) this->legs.size();
+}
+
+template <typename Scalar>
+int BasicMotionProfileTrajectory<Scalar>::get_segment_count() const {
+	return (int) this->segments.size();
+}
+
+template <typename Scalar>
+const BasicMotionProfileSegment<Scalar>* BasicMotionProfileTrajectory<Scalar>::get_segments() const {
+	return this->segments.data();
+}
+
+template <typename Scalar>
+Scalar BasicMotionProfileTrajectory<Scalar>::get_waypoint_velocity(int waypoint_index) const {
+	return this->junctions[waypoint_index].velocity;
+}
+
+template <typename Scalar>
+Scalar BasicMotionProfileTrajectory<Scalar>::get_time_end() const {
+	return this->time_end;
+}
+
+template <typename Scalar>
+Scalar BasicMotionProfileTrajectory<Scalar>::get_time_distance(Scalar progress_time) const {
+	if (this->segments.empty()) return this->distance_begin;
+	progress_time = this->trajectory_time_clamp(progress_time);
+	const BasicMotionProfileSegment<Scalar>& segment = this->segments[this->trajectory_segment_index(progress_time)];
+	return motion_profile_segment_distance(segment, progress_time - segment.time_begin);
+}
+
+template <typename Scalar>
+Scalar BasicMotionProfileTrajectory<Scalar>::get_time_velocity(Scalar progress_time) const {
+	if (this->segments.empty()) return 0;
+	progress_time = this->trajectory_time_clamp(progress_time);
+	const BasicMotionProfileSegment<Scalar>& segment = this->segments[this->trajectory_segment_index(progress_time)];
+	return motion_profile_segment_velocity(segment, progress_time - segment.time_begin);
+}
+
+template <typename Scalar>
+Scalar BasicMotionProfileTrajectory<Scalar>::get_time_acceleration(Scalar progress_time) const {
+	if (this->segments.empty()) return 0;
+	progress_time = this->trajectory_time_clamp(progress_time);
+	const BasicMotionProfileSegment<Scalar>& segment = this->segments[this->trajectory_segment_index(progress_time)];
+	return motion_profile_segment_acceleration(segment, progress_time - segment.time_begin);
+}
+
+template <typename Scalar>
+Scalar BasicMotionProfileTrajectory<Scalar>::get_time_jerk(Scalar progress_time) const {
+	if (this->segments.empty()) return 0;
+	return motion_profile_segment_jerk(this->segments[this->trajectory_segment_index(this->trajectory_time_clamp(progress_time))]);
+}
+
+template <typename Scalar>
+Scalar BasicMotionProfileTrajectory<Scalar>::get_distance_time(Scalar progress_distance) const {
+	if (this->segments.empty()) return 0;
+	int                                      segment_index    = this->trajectory_segment_index_distance(progress_distance);
+	const BasicMotionProfileSegment<Scalar>& segment          = this->segments[segment_index];
+	Scalar                                   time_section_max = (segment_index + 1 < (int) this->segments.size() ? this->segments[segment_index + 1].time_begin : this->time_end) - segment.time_begin;
+	return segment.time_begin + motion_profile_segment_solve(segment, time_section_max, progress_distance - segment.cubic_degree_zero, Scalar(-1));
+}
+
+template <typename Scalar>
+Scalar BasicMotionProfileTrajectory<Scalar>::get_distance_velocity(Scalar progress_distance) const {
+	return this->get_time_velocity(this->get_distance_time(progress_distance));
+}
+
+template <typename Scalar>
+Scalar BasicMotionProfileTrajectory<Scalar>::get_distance_acceleration(Scalar progress_distance) const {
+	return this->get_time_acceleration(this->get_distance_time(progress_distance));
+}
+
+template <typename Scalar>
+int BasicMotionProfileTrajectory<Scalar>::trajectory_segment_index(Scalar progress_time) const {
+	return motion_profile_segment_search_binary(this->segments.data(), (int) this->segments.size(), progress_time);
+}
+
+template <typename Scalar>
+int BasicMotionProfileTrajectory<Scalar>::trajectory_segment_index_distance(Scalar progress_distance) const {
+	return motion_profile_segment_search_distance_binary(this->segments.data(), (int) this->segments.size(), progress_distance);
+}
+
+template <typename Scalar>
+Scalar BasicMotionProfileTrajectory<Scalar>::trajectory_time_clamp(Scalar progress_time) const {
+	// the path rests at both ends
+	return std::min(std::max(progress_time, Scalar(0)), this->time_end);
+}
+
+template <typename Scalar>
+void BasicMotionProfileTrajectory<Scalar>::trajectory_leg_plan(int leg_index) {
+	TrajectoryLeg&            leg              = this->legs[leg_index];
+	const TrajectoryWaypoint& waypoint         = leg.waypoint_end;
+	Scalar                    distance_section = waypoint.distance - leg.distance_begin;
+	Scalar                    velocity_begin   = this->junctions[leg_index].velocity;
+	Scalar                    velocity_end     = this->junctions[leg_index + 1].velocity;
+	leg.time_begin    = this->time_end;
+	leg.segment_begin = (int) this->segments.size();
+	BasicMotionProfileSegment<Scalar> leg_segments[7] = {};
+	Scalar                            leg_time        = 0;
+	int                               leg_segment_count;
+	if (waypoint.jerk > 0) {
+		typename BasicSigmoidMotionProfile<Scalar>::SigmoidPhaseAnchors phase_anchors[7] = {};
+		sigmoid_phase_anchors_boundary(distance_section, velocity_begin, velocity_end, waypoint.velocity_max, waypoint.acceleration_max, waypoint.jerk, phase_anchors);
+		sigmoid_phase_integrate(waypoint.jerk, velocity_begin, phase_anchors, leg_segments);
+		leg_time          = phase_anchors[6].time_phase_end;
+		leg_segment_count = 7;
+	} else {
+		// accelerate, slide and decelerate, with the peak velocity lowered when the leg is too short to reach the limit
+		Scalar acceleration   = waypoint.acceleration_max;
+		Scalar velocity_peak  = std::min(waypoint.velocity_max, motion_profile_sqrt(acceleration * distance_section + (velocity_begin * velocity_begin + velocity_end * velocity_end) / 2));
+		velocity_peak         = std::max(velocity_peak, std::max(velocity_begin, velocity_end));
+		Scalar time_speeding  = (velocity_peak - velocity_begin) / acceleration;
+		Scalar time_slowing   = (velocity_peak - velocity_end) / acceleration;
+		Scalar distance_speed = (velocity_begin + velocity_peak) / 2 * time_speeding;
+		Scalar distance_slow  = (velocity_end + velocity_peak) / 2 * time_slowing;
+		Scalar time_sliding   = std::max((distance_section - distance_speed - distance_slow) / velocity_peak, Scalar(0));
+		leg_segments[0]   = {0,                            0, acceleration / 2,        velocity_begin, 0};
+		leg_segments[1]   = {time_speeding,                0, 0,                       velocity_peak,  distance_speed};
+		leg_segments[2]   = {time_speeding + time_sliding, 0, (-1) * acceleration / 2, velocity_peak,  distance_speed + velocity_peak * time_sliding};
+		leg_time          = time_speeding + time_sliding + time_slowing;
+		leg_segment_count = 3;
+	}
+	// phases without duration are left out of the table (a leg keeps at least its first one)
+	for (int segment_index = 0; segment_index < leg_segment_count; segment_index++) {
+		Scalar segment_time_end = (segment_index + 1 < leg_segment_count ? leg_segments[segment_index + 1].time_begin : leg_time);
+		if (!(segment_time_end > leg_segments[segment_index].time_begin) && !(segment_index == 0 && leg_time <= 0)) continue;
+		BasicMotionProfileSegment<Scalar> segment = leg_segments[segment_index];
+		segment.time_begin        += leg.time_begin;
+		segment.cubic_degree_zero += leg.distance_begin;
+		this->segments.push_back(segment);
+	}
+	this->time_end = leg.time_begin + leg_time;
+}
+
+template <typename Scalar>
+Scalar motion_profile_trajectory_velocity_reach(Scalar velocity_from, Scalar distance, Scalar acceleration_max, Scalar jerk) {
+	// fastest velocity a ramp starting at velocity_from reaches within the distance (also the fastest velocity that can
+	// still ramp down to velocity_from within it)
+	if (!(jerk > 0)) return motion_profile_sqrt(velocity_from * velocity_from + 2 * acceleration_max * distance);
+	Scalar velocity_change_full = acceleration_max * acceleration_max / jerk; // change at which the ramp reaches the acceleration limit
+	if (distance >= (2 * velocity_from + velocity_change_full) * acceleration_max / jerk) {
+		// the ramp holds the acceleration limit: (v^2 - v0^2) / a + (v + v0) a / j = 2 distance
+		Scalar equation_b = acceleration_max / jerk;
+		Scalar equation_c = velocity_from * acceleration_max / jerk - velocity_from * velocity_from / acceleration_max - 2 * distance;
+		return (equation_b * (-1) + motion_profile_sqrt(equation_b * equation_b - 4 * equation_c / acceleration_max)) * acceleration_max / 2;
+	}
+	// the ramp is pure jerk: (2 v0 + dv)^2 dv = distance^2 j, newton from the upper end converges monotonically (convex)
+	Scalar distance_square = distance * distance * jerk;
+	Scalar velocity_change = velocity_change_full;
+	for (int iteration = 0; iteration < MOTION_PROFILE_TRAJECTORY_REACH_ITERATIONS; iteration++) {
+		Scalar velocity_sum         = 2 * velocity_from + velocity_change;
+		Scalar equation_error       = velocity_sum * velocity_sum * velocity_change - distance_square;
+		Scalar velocity_change_next = velocity_change - equation_error / (velocity_sum * (velocity_sum + 2 * velocity_change));
+		if (!(velocity_change_next < velocity_change)) break;
+		velocity_change = velocity_change_next;
+	}
+	return velocity_from + std::max(velocity_change, Scalar(0));
+}
\ No newline at end of file
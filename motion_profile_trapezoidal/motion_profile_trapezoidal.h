@@ -1,19 +1,249 @@
 #pragma once
+#include <algorithm>
+#include <type_traits>
+#include "../motion_profile_segment/motion_profile_segment.h"
+#include "../motion_profile_interface/motion_profile_interface.h"
 
-class TrapezoidalMotionProfile {
+/**
+ * Trapezoidal (acceleration limited) motion profile over a scalar type
+ * 
+ * Construction and the time and distance queries are constexpr, every distance query is in closed form. The batch,
+ * inverse batch and cursor paths come from the shared MotionProfileInterface and are float only, the inverse batch
+ * runs the closed form through the interface hook.
+ */
+template <typename Scalar = float>
+class BasicTrapezoidalMotionProfile : public MotionProfileInterface<BasicTrapezoidalMotionProfile<Scalar>, Scalar> {
+
+public:
+    enum class TrapezoidalPhase {
+        ACCELERATE,
+        SLIDE,
+        DECELERATE
+    };
 
 private:
-    float motion_distance;
-    float motion_velocity_max;
-    float motion_acceleration;
-    float motion_time_full;
-    float motion_time_sliding;
-    float motion_time_speeding;
+    Scalar motion_distance          = 0;
+    Scalar motion_velocity_max      = 0;
+    Scalar motion_acceleration      = 0;
+    Scalar motion_time_full         = 0;
+    Scalar motion_time_sliding      = 0;
+    Scalar motion_time_speeding     = 0;
+    Scalar motion_distance_speeding = 0; // distance covered while accelerating (and while decelerating)
+    Scalar motion_distance_sliding  = 0;
+    BasicMotionProfileSegment<Scalar> motion_segments[3] = {};
 
 public:
-    TrapezoidalMotionProfile(float distance, float velocity_max, float acceleration);
-    float get_distance(float time);
-    float get_velocity(float time);
-    float get_time();
+    constexpr BasicTrapezoidalMotionProfile(Scalar distance, Scalar velocity_max, Scalar acceleration) noexcept;
+    constexpr Scalar get_distance(Scalar time) const noexcept;
+    constexpr Scalar get_velocity(Scalar time) const noexcept;
+    constexpr Scalar get_time() const noexcept;
+    constexpr Scalar get_time_distance(Scalar time) const noexcept { return this->get_distance(time); }
+    constexpr Scalar get_time_velocity(Scalar time) const noexcept { return this->get_velocity(time); }
+    constexpr Scalar get_time_acceleration(Scalar time) const noexcept;
+    constexpr Scalar get_time_jerk(Scalar) const noexcept { return 0; }
+    constexpr Scalar get_time_end() const noexcept { return this->motion_time_full; }
+    constexpr Scalar get_distance_time(Scalar distance) const noexcept;
+    constexpr Scalar get_distance_velocity(Scalar distance) const noexcept;
+    constexpr Scalar get_distance_acceleration(Scalar distance) const noexcept;
+    constexpr Scalar get_distance_jerk(Scalar) const noexcept { return 0; }
+    void profile_distance_time_batch(const float* distances, size_t distance_count, float* times) const noexcept;
+    constexpr TrapezoidalPhase get_phase(Scalar time) const noexcept;
+    constexpr const BasicMotionProfileSegment<Scalar>* get_segments() const noexcept;
+    constexpr int get_segment_count() const noexcept { return 3; }
+
+};
+
+using TrapezoidalMotionProfile = BasicTrapezoidalMotionProfile<float>;
+
+/**
+ * Construct a new Motion Profile object
+ * 
+ * @param distance The total distance of the path
+ * @param velocity_max The maximum velocity during the motion
+ * @param acceleration The acceleration of the motion
+ */
+template <typename Scalar>
+constexpr BasicTrapezoidalMotionProfile<Scalar>::BasicTrapezoidalMotionProfile(Scalar distance, Scalar velocity_max, Scalar acceleration) noexcept {
+    MOTION_PROFILE_INSTRUMENT_CALL(MotionProfileApi::TRAPEZOIDAL_CONSTRUCT);
+    // constants
+    this->motion_distance      = distance;
+    this->motion_acceleration  = acceleration;
+    // calculates the reachable maximum velocity
+    Scalar velocity_max_actual = std::min(motion_profile_sqrt(acceleration * distance), velocity_max);
+    this->motion_velocity_max  = velocity_max_actual;
+    // calculates the time of motion
+    Scalar speeding_time       = velocity_max_actual / acceleration; // for either accelerate/decelerate
+    Scalar speeding_distance   = velocity_max_actual * speeding_time;
+    Scalar sliding_distance    = distance - speeding_distance;
+    Scalar sliding_time        = sliding_distance / velocity_max_actual;
+    this->motion_time_speeding = speeding_time;
+    this->motion_time_sliding  = sliding_time;
+    this->motion_time_full     = 2 * speeding_time + sliding_time;
+    // accelerate, slide and decelerate as constant-jerk segments (for batch evaluation)
+    Scalar accelerate_distance     = speeding_distance / 2;
+    this->motion_distance_speeding = accelerate_distance;
+    this->motion_distance_sliding  = sliding_distance;
+    this->motion_segments[0]   = {0,                            0, acceleration / 2,        0,                   0};
+    this->motion_segments[1]   = {speeding_time,                0, 0,                       velocity_max_actual, accelerate_distance};
+    this->motion_segments[2]   = {speeding_time + sliding_time, 0, (-1) * acceleration / 2, velocity_max_actual, accelerate_distance + sliding_distance};
+}
+
+/**
+ * Calculates the instantaneous distance at time
+ * 
+ * @param time The time since the start of the motion
+ * @return instantaneous distance at time
+ */
+template <typename Scalar>
+constexpr Scalar BasicTrapezoidalMotionProfile<Scalar>::get_distance(Scalar time) const noexcept {
+    MOTION_PROFILE_INSTRUMENT_CALL(MotionProfileApi::TRAPEZOIDAL_GET_DISTANCE);
+    Scalar distance_net = 0;
+    // accelerate
+    Scalar accelerate_time = std::min(time, this->motion_time_speeding);
+    distance_net += this->motion_acceleration / 2 * (accelerate_time * accelerate_time);
+    // slide
+    Scalar slide_time = std::min(time - this->motion_time_speeding, this->motion_time_sliding);
+    if (slide_time > 0) distance_net += this->motion_velocity_max * slide_time;
+    // decelerate
+    Scalar decelerate_time = time - this->motion_time_speeding - this->motion_time_sliding;
+    if (decelerate_time > 0) distance_net += this->motion_velocity_max * decelerate_time - this->motion_acceleration / 2 * (decelerate_time * decelerate_time);
+    return distance_net;
+}
+
+/**
+ * Calculates the instantaneous velocity at time
+ * 
+ * @param time The time since the start of the motion
+ * @return Instantaneous velocity
+ */
+template <typename Scalar>
+constexpr Scalar BasicTrapezoidalMotionProfile<Scalar>::get_velocity(Scalar time) const noexcept {
+    MOTION_PROFILE_INSTRUMENT_CALL(MotionProfileApi::TRAPEZOIDAL_GET_VELOCITY);
+    // accelerate
+    if (time < this->motion_time_speeding) return this->motion_acceleration * time;
+    // slide
+    if (time < this->motion_time_speeding + this->motion_time_sliding) return this->motion_velocity_max;
+    // decelerate
+    return this->motion_velocity_max - this->motion_acceleration * (time - (this->motion_time_speeding + this->motion_time_sliding));
+}
+
+/**
+ * Calculates the total time of the motion
+ * 
+ * @return Total time of the motion
+ */
+template <typename Scalar>
+constexpr Scalar BasicTrapezoidalMotionProfile<Scalar>::get_time() const noexcept {
+    return this->motion_time_full;
+}
+
+/**
+ * Calculates the instantaneous acceleration at time
+ * 
+ * @param time The time since the start of the motion
+ * @return Acceleration of the phase the time falls in (zero outside the motion)
+ */
+template <typename Scalar>
+constexpr Scalar BasicTrapezoidalMotionProfile<Scalar>::get_time_acceleration(Scalar time) const noexcept {
+    MOTION_PROFILE_INSTRUMENT_CALL(MotionProfileApi::TRAPEZOIDAL_GET_TIME_ACCELERATION);
+    // at rest before the start and after the end
+    if (!(time >= 0) || time >= this->get_time_end()) return 0;
+    switch (this->get_phase(time)) {
+        case TrapezoidalPhase::ACCELERATE: return this->motion_acceleration;
+        case TrapezoidalPhase::SLIDE:      return 0;
+        default:                           return (-1) * this->motion_acceleration;
+    }
+}
+
+/**
+ * Calculates the time a distance is reached
+ * 
+ * @param distance The distance since the start of the motion
+ * @return Time since the start of the motion, clamped to [0, total time]
+ */
+template <typename Scalar>
+constexpr Scalar BasicTrapezoidalMotionProfile<Scalar>::get_distance_time(Scalar distance) const noexcept {
+    MOTION_PROFILE_INSTRUMENT_CALL(MotionProfileApi::TRAPEZOIDAL_GET_DISTANCE_TIME);
+    if (!(distance > 0)) return 0;
+    if (distance >= this->motion_distance) return this->motion_time_full;
+    // accelerate
+    if (distance < this->motion_distance_speeding) return motion_profile_sqrt(2 * distance / this->motion_acceleration);
+    // slide
+    if (distance < this->motion_distance_speeding + this->motion_distance_sliding) return this->motion_time_speeding + (distance - this->motion_distance_speeding) / this->motion_velocity_max;
+    // decelerate (the acceleration mirrored from the end)
+    return this->motion_time_full - motion_profile_sqrt(2 * (this->motion_distance - distance) / this->motion_acceleration);
+}
+
+/**
+ * Calculates the velocity at a distance
+ * 
+ * @param distance The distance since the start of the motion
+ * @return Velocity when the distance is reached (zero outside the motion)
+ */
+template <typename Scalar>
+constexpr Scalar BasicTrapezoidalMotionProfile<Scalar>::get_distance_velocity(Scalar distance) const noexcept {
+    MOTION_PROFILE_INSTRUMENT_CALL(MotionProfileApi::TRAPEZOIDAL_GET_DISTANCE_VELOCITY);
+    distance = std::min(std::max(distance, Scalar(0)), this->motion_distance);
+    // accelerate
+    if (distance < this->motion_distance_speeding) return motion_profile_sqrt(2 * this->motion_acceleration * distance);
+    // slide
+    if (distance < this->motion_distance_speeding + this->motion_distance_sliding) return this->motion_velocity_max;
+    // decelerate
+    return motion_profile_sqrt(2 * this->motion_acceleration * (this->motion_distance - distance));
+}
+
+/**
+ * Calculates the acceleration at a distance
+ * 
+ * @param distance The distance since the start of the motion
+ * @return Acceleration of the phase the distance falls in (zero outside the motion)
+ */
+template <typename Scalar>
+constexpr Scalar BasicTrapezoidalMotionProfile<Scalar>::get_distance_acceleration(Scalar distance) const noexcept {
+    MOTION_PROFILE_INSTRUMENT_CALL(MotionProfileApi::TRAPEZOIDAL_GET_DISTANCE_ACCELERATION);
+    // at rest before the start and past the end, like the velocity
+    if (!(distance >= 0 && distance <= this->motion_distance)) return 0;
+    // accelerate
+    if (distance < this->motion_distance_speeding) return this->motion_acceleration;
+    // slide
+    if (distance < this->motion_distance_speeding + this->motion_distance_sliding) return 0;
+    // decelerate
+    return (-1) * this->motion_acceleration;
+}
+
+/**
+ * Calculates the time of every distance in closed form (interface hook behind get_distance_time_batch, replaces the
+ * iterative inverse of the shared interface)
+ * 
+ * @param distances The distances since the start of the motion
+ * @param distance_count The number of distances
+ * @param times The output, distance_count times clamped to [0, total time]
+ */
+template <typename Scalar>
+void BasicTrapezoidalMotionProfile<Scalar>::profile_distance_time_batch(const float* distances, size_t distance_count, float* times) const noexcept {
+    static_assert(std::is_same<Scalar, float>::value, "batch evaluation is float only");
+    for (size_t distance_index = 0; distance_index < distance_count; distance_index++) times[distance_index] = this->get_distance_time(distances[distance_index]);
+}
+
+/**
+ * Gives the phase of the motion at time
+ * 
+ * @param time The time since the start of the motion
+ * @return Phase the time falls in (before the start it accelerates, after the end it decelerates)
+ */
+template <typename Scalar>
+constexpr auto BasicTrapezoidalMotionProfile<Scalar>::get_phase(Scalar time) const noexcept -> TrapezoidalPhase {
+    if (time < this->motion_time_speeding) return TrapezoidalPhase::ACCELERATE;
+    if (time < this->motion_time_speeding + this->motion_time_sliding) return TrapezoidalPhase::SLIDE;
+    return TrapezoidalPhase::DECELERATE;
+}
 
-};
\ No newline at end of file
+/**
+ * Gives the constant-jerk segments of the motion (accelerate, slide and decelerate)
+ * 
+ * @return The 3 segments, in time since the start of the motion
+ */
+template <typename Scalar>
+constexpr const BasicMotionProfileSegment<Scalar>* BasicTrapezoidalMotionProfile<Scalar>::get_segments() const noexcept {
+    return this->motion_segments;
+}
\ No newline at end of file